@@ -0,0 +1,638 @@
+/**
+ * @file	ble-protocol-bench.cpp
+ * @brief	Google Benchmark suite for the BLE protocol helpers
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Measures every make/pack/unpack/validate/flag helper in
+ * protocol/ble-protocol.hpp, both for a single packet and for batches of
+ * 1k..1M back-to-back buffers. Batch benchmarks come in two flavours:
+ *
+ * - hot:  the same working set is reused, so it stays cache resident
+ *	   as far as its size allows;
+ * - cold: an eviction buffer of twice the last-level cache (as reported
+ *	   by sysconf(), at least 64 MB) is walked (untimed) before every
+ *	   iteration. The size used is printed in the run context.
+ *
+ * Batch results report items/s (packets per second) and time_per_packet.
+ * This is the baseline any codec change on the gateway hot path is
+ * compared against.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../protocol/ble-protocol-bulk.hpp"
+#include "../protocol/ble-protocol.hpp"
+
+namespace
+{
+
+/**
+ * @brief Benchmark sizing constants.
+ */
+struct bench_constants_t final
+{
+	static constexpr std::int64_t batch_min = 1 << 10;
+	static constexpr std::int64_t batch_max = 1 << 20;
+	static constexpr std::size_t eviction_min_bytes = 64u * 1024u * 1024u;
+	/* Eviction dominates wall time, so cold runs use fixed iterations. */
+	static constexpr benchmark::IterationCount cold_iterations = 32;
+};
+
+/**
+ * @brief Eviction buffer size: twice the largest cache level reported.
+ */
+std::size_t bench_eviction_bytes()
+{
+	long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+
+	if (llc <= 0)
+	{
+		llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+	}
+
+	const std::size_t bytes = (llc > 0) ? (2u * static_cast<std::size_t>(llc)) : 0u;
+
+	return (bytes > bench_constants_t::eviction_min_bytes)
+		   ? bytes
+		   : bench_constants_t::eviction_min_bytes;
+}
+
+/**
+ * @brief Walk a buffer larger than the LLC to evict the working set.
+ */
+void bench_evict_caches()
+{
+	static std::vector<std::uint8_t> eviction(bench_eviction_bytes());
+	static std::uint8_t tick = 0u;
+
+	++tick;
+	for (std::size_t i = 0u; i < eviction.size(); i += 64u)
+	{
+		eviction[i] = static_cast<std::uint8_t>(eviction[i] + tick);
+	}
+	benchmark::ClobberMemory();
+}
+
+/**
+ * @brief Run a per-packet operation over a batch, hot or cold.
+ * @param state Benchmark state; range(0) is the batch size.
+ * @param cold true to evict caches before each iteration.
+ * @param op Callable invoked with the packet index.
+ */
+template <typename Op>
+void bench_batch(benchmark::State &state, bool cold, Op op)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		if (cold)
+		{
+			state.PauseTiming();
+			bench_evict_caches();
+			state.ResumeTiming();
+		}
+		for (std::size_t i = 0u; i < count; ++i)
+		{
+			op(i);
+		}
+		benchmark::ClobberMemory();
+	}
+
+	const double packets =
+	    static_cast<double>(state.iterations()) * static_cast<double>(count);
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(packets));
+	state.counters["time_per_packet"] = benchmark::Counter(
+	    packets, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+/**
+ * @brief Varied telemetry packets so branches and values are realistic.
+ */
+std::vector<telemetry_packet_t> bench_telemetry_packets(std::size_t count)
+{
+	std::vector<telemetry_packet_t> pkts(count);
+
+	for (std::size_t i = 0u; i < count; ++i)
+	{
+		pkts[i] = ble_make_telemetry(ble_node_id_t::sn2);
+		pkts[i].flags = static_cast<std::uint16_t>(i & 0x7u);
+		pkts[i].primary_value = static_cast<std::int16_t>(2000 + (i % 700u));
+		pkts[i].secondary_value = static_cast<std::int16_t>(i & 1u);
+		pkts[i].potentiometer_raw = static_cast<std::uint16_t>(i & 0xFFFu);
+		pkts[i].duty_commanded = static_cast<std::uint16_t>(i % 1001u);
+	}
+
+	return pkts;
+}
+
+std::vector<event_packet_t> bench_event_packets(std::size_t count)
+{
+	std::vector<event_packet_t> pkts(count);
+
+	for (std::size_t i = 0u; i < count; ++i)
+	{
+		pkts[i] = ble_make_event(ble_node_id_t::sn2,
+					 ble_event_type_t::sound_detected,
+					 static_cast<std::int16_t>(i & 0x7FFu),
+					 static_cast<std::uint16_t>(i));
+	}
+
+	return pkts;
+}
+
+std::vector<control_packet_t> bench_control_packets(std::size_t count)
+{
+	std::vector<control_packet_t> pkts(count);
+
+	for (std::size_t i = 0u; i < count; ++i)
+	{
+		pkts[i] = ble_make_control(ble_node_id_t::sn2,
+					   static_cast<std::uint16_t>(i & 0x3u),
+					   static_cast<std::uint16_t>(i % 1001u));
+	}
+
+	return pkts;
+}
+
+/**
+ * @brief Contiguous wire buffers holding copies of a test vector.
+ */
+template <std::size_t N>
+std::vector<std::uint8_t> bench_wire_buffers(const std::uint8_t (&vector)[N],
+					     std::size_t count)
+{
+	std::vector<std::uint8_t> bytes(count * N);
+
+	for (std::size_t i = 0u; i < count; ++i)
+	{
+		for (std::size_t j = 0u; j < N; ++j)
+		{
+			bytes[(i * N) + j] = vector[j];
+		}
+	}
+
+	return bytes;
+}
+
+/* ------------------------------------------------------------------ */
+/* Single packet                                                       */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Every input passes through benchmark::DoNotOptimize() on every
+ * iteration, so the compiler cannot treat it as a constant and fold the
+ * work out of the loop.
+ */
+
+void BM_make_telemetry(benchmark::State &state)
+{
+	ble_node_id_t node = ble_node_id_t::sn2;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(node);
+
+		telemetry_packet_t pkt = ble_make_telemetry(node);
+
+		benchmark::DoNotOptimize(pkt);
+	}
+}
+BENCHMARK(BM_make_telemetry);
+
+void BM_make_event(benchmark::State &state)
+{
+	ble_event_type_t type = ble_event_type_t::sound_detected;
+	std::int16_t value = 0;
+	std::uint16_t timestamp = 0x1234u;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(type);
+		benchmark::DoNotOptimize(value);
+		benchmark::DoNotOptimize(timestamp);
+
+		event_packet_t pkt =
+		    ble_make_event(ble_node_id_t::sn2, type, value, timestamp);
+
+		benchmark::DoNotOptimize(pkt);
+	}
+}
+BENCHMARK(BM_make_event);
+
+void BM_make_control(benchmark::State &state)
+{
+	std::uint16_t flags = ble_control_flag_mask(ble_control_flag_t::override_enable);
+	std::uint16_t duty = 750u;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(flags);
+		benchmark::DoNotOptimize(duty);
+
+		control_packet_t pkt = ble_make_control(ble_node_id_t::sn2, flags, duty);
+
+		benchmark::DoNotOptimize(pkt);
+	}
+}
+BENCHMARK(BM_make_control);
+
+void BM_pack_telemetry(benchmark::State &state)
+{
+	telemetry_packet_t pkt = bench_telemetry_packets(1u)[0];
+	std::uint8_t buf[sizeof(telemetry_packet_t)];
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(pkt);
+		benchmark::DoNotOptimize(ble_pack_telemetry(buf, sizeof(buf), pkt));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_pack_telemetry);
+
+void BM_pack_event(benchmark::State &state)
+{
+	event_packet_t pkt = bench_event_packets(1u)[0];
+	std::uint8_t buf[sizeof(event_packet_t)];
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(pkt);
+		benchmark::DoNotOptimize(ble_pack_event(buf, sizeof(buf), pkt));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_pack_event);
+
+void BM_pack_control(benchmark::State &state)
+{
+	control_packet_t pkt = ble_make_control(ble_node_id_t::sn2, 1u, 750u);
+	std::uint8_t buf[sizeof(control_packet_t)];
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(pkt);
+		benchmark::DoNotOptimize(ble_pack_control(buf, sizeof(buf), pkt));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_pack_control);
+
+/**
+ * @brief Unpack one test vector from a laundered copy per iteration.
+ */
+template <typename Packet, std::size_t N, typename Unpack>
+void bench_unpack_one(benchmark::State &state, const std::uint8_t (&vector)[N],
+		      Unpack unpack)
+{
+	std::uint8_t buf[N];
+	Packet pkt{};
+
+	std::memcpy(buf, vector, N);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(buf);
+		benchmark::DoNotOptimize(unpack(pkt, buf, sizeof(buf)));
+		benchmark::DoNotOptimize(pkt);
+	}
+}
+
+void BM_unpack_telemetry(benchmark::State &state)
+{
+	bench_unpack_one<telemetry_packet_t>(state, BLE_TEST_TELEM_1,
+					     ble_unpack_telemetry);
+}
+BENCHMARK(BM_unpack_telemetry);
+
+void BM_unpack_event(benchmark::State &state)
+{
+	bench_unpack_one<event_packet_t>(state, BLE_TEST_EVENT_1, ble_unpack_event);
+}
+BENCHMARK(BM_unpack_event);
+
+void BM_unpack_control(benchmark::State &state)
+{
+	bench_unpack_one<control_packet_t>(state, BLE_TEST_CTRL_1, ble_unpack_control);
+}
+BENCHMARK(BM_unpack_control);
+
+void BM_validate_protocol_version(benchmark::State &state)
+{
+	std::uint8_t buf[sizeof(BLE_TEST_TELEM_1)];
+
+	std::memcpy(buf, BLE_TEST_TELEM_1, sizeof(buf));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(buf);
+		benchmark::DoNotOptimize(ble_validate_protocol_version(
+		    ble_protocol_version_t::v1, buf, sizeof(buf)));
+	}
+}
+BENCHMARK(BM_validate_protocol_version);
+
+void BM_telemetry_view(benchmark::State &state)
+{
+	std::uint8_t buf[sizeof(BLE_TEST_TELEM_1)];
+	telemetry_view_t view{nullptr};
+
+	std::memcpy(buf, BLE_TEST_TELEM_1, sizeof(buf));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(buf);
+		benchmark::DoNotOptimize(ble_view_telemetry(view, buf, sizeof(buf)));
+		benchmark::DoNotOptimize(view.primary_value());
+	}
+}
+BENCHMARK(BM_telemetry_view);
+
+void BM_flag_helpers(benchmark::State &state)
+{
+	std::uint16_t flags = 0u;
+	bool set = true;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(flags);
+		benchmark::DoNotOptimize(set);
+		flags = ble_telemetry_flag_update(
+		    flags, ble_telemetry_flag_t::help_active, set);
+		benchmark::DoNotOptimize(ble_telemetry_flag_is_set(
+		    flags, ble_telemetry_flag_t::help_active));
+		benchmark::DoNotOptimize(ble_control_flag_is_set(
+		    flags, ble_control_flag_t::override_enable));
+	}
+}
+BENCHMARK(BM_flag_helpers);
+
+void BM_clamp_duty(benchmark::State &state)
+{
+	std::uint16_t duty = 1200u;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(duty);
+		benchmark::DoNotOptimize(ble_clamp_duty_per_mille(duty));
+	}
+}
+BENCHMARK(BM_clamp_duty);
+
+/* ------------------------------------------------------------------ */
+/* Batches of 1k..1M buffers, hot and cold                             */
+/* ------------------------------------------------------------------ */
+
+void BM_batch_make_telemetry(benchmark::State &state, bool cold)
+{
+	std::vector<telemetry_packet_t> out(
+	    static_cast<std::size_t>(state.range(0)));
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		out[i] = ble_make_telemetry(ble_node_id_t::sn2);
+	});
+}
+
+void BM_batch_make_event(benchmark::State &state, bool cold)
+{
+	std::vector<event_packet_t> out(static_cast<std::size_t>(state.range(0)));
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		out[i] = ble_make_event(ble_node_id_t::sn2,
+					static_cast<ble_event_type_t>(1u + (i & 0x3u)),
+					static_cast<std::int16_t>(i & 0x7FFu),
+					static_cast<std::uint16_t>(i));
+	});
+}
+
+void BM_batch_make_control(benchmark::State &state, bool cold)
+{
+	std::vector<control_packet_t> out(static_cast<std::size_t>(state.range(0)));
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		out[i] = ble_make_control(ble_node_id_t::sn2,
+					  static_cast<std::uint16_t>(i & 0x3u),
+					  static_cast<std::uint16_t>(i % 1201u));
+	});
+}
+
+void BM_batch_pack_telemetry(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<telemetry_packet_t> pkts = bench_telemetry_packets(count);
+	std::vector<std::uint8_t> out(count * sizeof(telemetry_packet_t));
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		(void)ble_pack_telemetry(&out[i * sizeof(telemetry_packet_t)],
+					 sizeof(telemetry_packet_t), pkts[i]);
+	});
+}
+
+void BM_batch_pack_event(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<event_packet_t> pkts = bench_event_packets(count);
+	std::vector<std::uint8_t> out(count * sizeof(event_packet_t));
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		(void)ble_pack_event(&out[i * sizeof(event_packet_t)],
+				     sizeof(event_packet_t), pkts[i]);
+	});
+}
+
+void BM_batch_pack_control(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<control_packet_t> pkts = bench_control_packets(count);
+	std::vector<std::uint8_t> out(count * sizeof(control_packet_t));
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		(void)ble_pack_control(&out[i * sizeof(control_packet_t)],
+				       sizeof(control_packet_t), pkts[i]);
+	});
+}
+
+void BM_batch_unpack_telemetry(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::uint8_t> in =
+	    bench_wire_buffers(BLE_TEST_TELEM_1, count);
+	std::vector<telemetry_packet_t> out(count);
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		(void)ble_unpack_telemetry(out[i],
+					   &in[i * sizeof(telemetry_packet_t)],
+					   sizeof(telemetry_packet_t));
+	});
+}
+
+void BM_batch_unpack_event(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::uint8_t> in =
+	    bench_wire_buffers(BLE_TEST_EVENT_1, count);
+	std::vector<event_packet_t> out(count);
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		(void)ble_unpack_event(out[i], &in[i * sizeof(event_packet_t)],
+				       sizeof(event_packet_t));
+	});
+}
+
+void BM_batch_unpack_control(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::uint8_t> in =
+	    bench_wire_buffers(BLE_TEST_CTRL_1, count);
+	std::vector<control_packet_t> out(count);
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		(void)ble_unpack_control(out[i], &in[i * sizeof(control_packet_t)],
+					 sizeof(control_packet_t));
+	});
+}
+
+void BM_batch_flag_helpers(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<telemetry_packet_t> pkts = bench_telemetry_packets(count);
+	std::vector<std::uint16_t> out(count);
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		const std::uint16_t flags = ble_telemetry_flag_update(
+		    pkts[i].flags, ble_telemetry_flag_t::help_active,
+		    !ble_telemetry_flag_is_set(pkts[i].flags,
+					       ble_telemetry_flag_t::help_active));
+
+		out[i] = ble_control_flag_is_set(flags, ble_control_flag_t::override_enable)
+			     ? ble_clamp_duty_per_mille(pkts[i].duty_commanded)
+			     : flags;
+	});
+}
+
+void BM_batch_validate_protocol_version(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::uint8_t> in =
+	    bench_wire_buffers(BLE_TEST_TELEM_1, count);
+	std::size_t valid = 0u;
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		valid += ble_validate_protocol_version(
+			     ble_protocol_version_t::v1,
+			     &in[i * sizeof(telemetry_packet_t)],
+			     sizeof(telemetry_packet_t))
+			     ? 1u
+			     : 0u;
+	});
+	benchmark::DoNotOptimize(valid);
+}
+
+void BM_batch_telemetry_view(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::uint8_t> in =
+	    bench_wire_buffers(BLE_TEST_TELEM_1, count);
+	std::int32_t sum = 0;
+
+	bench_batch(state, cold, [&](std::size_t i) {
+		telemetry_view_t view{nullptr};
+
+		if (ble_view_telemetry(view, &in[i * sizeof(telemetry_packet_t)],
+				       sizeof(telemetry_packet_t)))
+		{
+			sum += view.primary_value();
+		}
+	});
+	benchmark::DoNotOptimize(sum);
+}
+
+void BM_batch_unpack_telemetry_bulk(benchmark::State &state, bool cold)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::uint8_t> in =
+	    bench_wire_buffers(BLE_TEST_TELEM_1, count);
+	std::vector<std::uint16_t> flags(count);
+	std::vector<std::int16_t> primary(count);
+	std::vector<std::int16_t> secondary(count);
+	std::vector<std::uint16_t> pot(count);
+	std::vector<std::uint16_t> duty(count);
+	const telemetry_columns_t columns{flags.data(), primary.data(),
+					  secondary.data(), pot.data(),
+					  duty.data()};
+
+	/* One call per iteration covers the whole batch. */
+	bench_batch(state, cold, [&](std::size_t i) {
+		if (i == 0u)
+		{
+			benchmark::DoNotOptimize(ble_unpack_telemetry_bulk(
+			    columns, in.data(), count, ble_node_id_t::sn2));
+		}
+	});
+}
+
+void bench_register_batches()
+{
+	struct entry_t final
+	{
+		const char *name;
+		void (*fn)(benchmark::State &, bool);
+	};
+
+	static const entry_t entries[] = {
+	    {"BM_batch_make_telemetry", BM_batch_make_telemetry},
+	    {"BM_batch_make_event", BM_batch_make_event},
+	    {"BM_batch_make_control", BM_batch_make_control},
+	    {"BM_batch_pack_telemetry", BM_batch_pack_telemetry},
+	    {"BM_batch_pack_event", BM_batch_pack_event},
+	    {"BM_batch_pack_control", BM_batch_pack_control},
+	    {"BM_batch_unpack_telemetry", BM_batch_unpack_telemetry},
+	    {"BM_batch_unpack_event", BM_batch_unpack_event},
+	    {"BM_batch_unpack_control", BM_batch_unpack_control},
+	    {"BM_batch_flag_helpers", BM_batch_flag_helpers},
+	    {"BM_batch_validate_protocol_version",
+	     BM_batch_validate_protocol_version},
+	    {"BM_batch_telemetry_view", BM_batch_telemetry_view},
+	    {"BM_batch_unpack_telemetry_bulk", BM_batch_unpack_telemetry_bulk},
+	};
+
+	for (const entry_t &entry : entries)
+	{
+		const std::string base(entry.name);
+
+		benchmark::RegisterBenchmark((base + "/hot").c_str(), entry.fn, false)
+		    ->RangeMultiplier(8)
+		    ->Range(bench_constants_t::batch_min, bench_constants_t::batch_max);
+		benchmark::RegisterBenchmark((base + "/cold").c_str(), entry.fn, true)
+		    ->RangeMultiplier(8)
+		    ->Range(bench_constants_t::batch_min, bench_constants_t::batch_max)
+		    ->Iterations(bench_constants_t::cold_iterations);
+	}
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	bench_register_batches();
+	benchmark::AddCustomContext("eviction_bytes", std::to_string(bench_eviction_bytes()));
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file	sn2-filter-bench.cpp
+ * @brief	Google Benchmark suite for the fixed-point sound filters
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Measures the Q15 biquad cascade and Q31 envelope follower of
+ * src/sn2-filter.hpp as the firmware runs them (one channel, one block
+ * at a time), the complete per-block sound detector, and the eight
+ * channel cascade of host/dsp/sn2-biquad-x8.hpp on its scalar and SIMD
+ * paths. Results report items/s (samples per second) and
+ * time_per_sample. The eight-channel benchmarks first check that both
+ * paths produce identical output and fail otherwise.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../host/dsp/sn2-biquad-x8.hpp"
+#include "../host/shim/sn2-sound-synth.hpp"
+#include "../src/sn2-filter.hpp"
+#include "../src/sn2-sound.hpp"
+
+namespace
+{
+
+/**
+ * @brief Benchmark sizing constants.
+ */
+struct bench_constants_t final
+{
+	static constexpr std::int64_t frames_min = 64;
+	static constexpr std::int64_t frames_max = 4096;
+	static constexpr std::size_t channels = 8u;
+	static constexpr std::size_t sections = sn2_sound_constants_t::sections;
+};
+
+constexpr sn2_biquad_q15_t bench_band[bench_constants_t::sections] = {
+    sn2_biquad_design_q15(sn2_biquad_type_t::highpass, 150.0, 0.7071, 8000.0),
+    sn2_biquad_design_q15(sn2_biquad_type_t::lowpass, 2500.0, 0.7071, 8000.0),
+};
+
+/**
+ * @brief Synthetic microphone samples (noise and tone bursts) in ADC counts.
+ */
+std::vector<std::uint16_t> bench_adc_samples(std::size_t count, std::uint32_t seed)
+{
+	std::vector<std::uint16_t> samples(count);
+	sound_synth_t synth;
+
+	sound_synth_init(synth, seed);
+	for (std::size_t i = 0u; i < count; ++i)
+	{
+		samples[i] = sound_synth_sample(synth);
+	}
+
+	return samples;
+}
+
+/**
+ * @brief Synthetic samples centred to Q15.
+ */
+std::vector<std::int16_t> bench_q15_samples(std::size_t count, std::uint32_t seed)
+{
+	const std::vector<std::uint16_t> adc = bench_adc_samples(count, seed);
+	std::vector<std::int16_t> samples(count);
+
+	for (std::size_t i = 0u; i < count; ++i)
+	{
+		samples[i] = static_cast<std::int16_t>((static_cast<std::int32_t>(adc[i]) - 2048) * 16);
+	}
+
+	return samples;
+}
+
+void bench_set_rate(benchmark::State &state, std::size_t samples_per_iteration)
+{
+	const double samples =
+	    static_cast<double>(state.iterations()) * static_cast<double>(samples_per_iteration);
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(samples));
+	state.counters["time_per_sample"] = benchmark::Counter(
+	    samples, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+/* ------------------------------------------------------------------ */
+/* Firmware path: one channel                                          */
+/* ------------------------------------------------------------------ */
+
+void BM_biquad_cascade_q15(benchmark::State &state)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::int16_t> in = bench_q15_samples(count, 1u);
+	std::vector<std::int16_t> out(count);
+	sn2_biquad_cascade_q15_t<bench_constants_t::sections> cascade;
+
+	sn2_biquad_cascade_init(cascade, bench_band);
+	for (auto _ : state)
+	{
+		sn2_biquad_cascade_process(cascade, in.data(), out.data(), count);
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	bench_set_rate(state, count);
+}
+BENCHMARK(BM_biquad_cascade_q15)
+    ->RangeMultiplier(8)
+    ->Range(bench_constants_t::frames_min, bench_constants_t::frames_max);
+
+void BM_envelope_q31(benchmark::State &state)
+{
+	const std::size_t count = static_cast<std::size_t>(state.range(0));
+	const std::vector<std::int16_t> in = bench_q15_samples(count, 2u);
+	sn2_envelope_q31_t env;
+
+	sn2_envelope_init(env, sn2_envelope_coeff_q15(1.0, 8000.0),
+			  sn2_envelope_coeff_q15(40.0, 8000.0));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(sn2_envelope_process(env, in.data(), count));
+	}
+	bench_set_rate(state, count);
+}
+BENCHMARK(BM_envelope_q31)
+    ->RangeMultiplier(8)
+    ->Range(bench_constants_t::frames_min, bench_constants_t::frames_max);
+
+void BM_sound_process_block(benchmark::State &state)
+{
+	const std::size_t block = sn2_sound_constants_t::block_samples;
+	const std::vector<std::uint16_t> in = bench_adc_samples(block * 1024u, 3u);
+	sn2_sound_detector_t detector;
+	std::size_t offset = 0u;
+
+	sn2_sound_init(detector, 100u, 6u, 8u);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(sn2_sound_process(detector, &in[offset], block));
+		offset = (offset + block) % in.size();
+	}
+	bench_set_rate(state, block);
+}
+BENCHMARK(BM_sound_process_block);
+
+/* ------------------------------------------------------------------ */
+/* Host path: eight interleaved channels                               */
+/* ------------------------------------------------------------------ */
+
+void BM_biquad_cascade_x8(benchmark::State &state, bool simd)
+{
+	const std::size_t frames = static_cast<std::size_t>(state.range(0));
+	const std::size_t count = frames * bench_constants_t::channels;
+	const std::vector<std::int16_t> in = bench_q15_samples(count, 4u);
+	std::vector<std::int16_t> out(count);
+	std::vector<std::int16_t> reference(count);
+	sn2_biquad_cascade_x8_t<bench_constants_t::sections> cascade;
+	sn2_biquad_cascade_x8_t<bench_constants_t::sections> check;
+
+	sn2_biquad_cascade_x8_init(check, bench_band);
+	sn2_biquad_cascade_x8_process(check, in.data(), reference.data(), frames, false);
+	sn2_biquad_cascade_x8_init(cascade, bench_band);
+	sn2_biquad_cascade_x8_process(cascade, in.data(), out.data(), frames, simd);
+	if (std::memcmp(out.data(), reference.data(), count * sizeof(std::int16_t)) != 0)
+	{
+		state.SkipWithError("SIMD output differs from scalar");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		sn2_biquad_cascade_x8_process(cascade, in.data(), out.data(), frames, simd);
+		benchmark::DoNotOptimize(out.data());
+		benchmark::ClobberMemory();
+	}
+	bench_set_rate(state, count);
+}
+BENCHMARK_CAPTURE(BM_biquad_cascade_x8, scalar, false)
+    ->RangeMultiplier(8)
+    ->Range(bench_constants_t::frames_min, bench_constants_t::frames_max);
+BENCHMARK_CAPTURE(BM_biquad_cascade_x8, simd, true)
+    ->RangeMultiplier(8)
+    ->Range(bench_constants_t::frames_min, bench_constants_t::frames_max);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+/**
+ * @file	sn2-median-bench.cpp
+ * @brief	Google Benchmark suite for the sorting-network median
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Compares sn2_median_select() of src/sn2-median.hpp with
+ * std::nth_element on the same windows of N = 3, 5, 7 and 9 ADC
+ * readings, plus the running median sn2_median_update() as the firmware
+ * calls it. Every iteration selects the median of a fresh window taken
+ * from a buffer of noisy readings with spikes, so neither path can learn
+ * a branch pattern. Results report items/s (medians per second) and
+ * time_per_median. The network benchmarks first check their medians
+ * against std::nth_element and fail on any mismatch.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/sn2-median.hpp"
+
+namespace
+{
+
+/**
+ * @brief Benchmark sizing constants.
+ */
+struct bench_constants_t final
+{
+	static constexpr std::size_t readings = 4096u; /* power of two */
+	static constexpr std::uint32_t seed = 1u;
+};
+
+/**
+ * @brief Potentiometer-like readings: a slow ramp, noise and 1 % spikes.
+ */
+std::vector<std::uint16_t> bench_readings()
+{
+	std::vector<std::uint16_t> readings(bench_constants_t::readings);
+	std::uint32_t state = bench_constants_t::seed;
+
+	for (std::size_t i = 0u; i < readings.size(); ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		const std::uint32_t spike = ((state >> 8) % 100u) == 0u;
+		const std::uint32_t value = 1000u + static_cast<std::uint32_t>(i / 2u) + (state % 16u);
+
+		readings[i] = static_cast<std::uint16_t>(spike ? ((state & 1u) ? 4095u : 0u) : value);
+	}
+
+	return readings;
+}
+
+template <std::size_t N>
+void bench_load(std::uint16_t (&v)[N], const std::vector<std::uint16_t> &readings,
+		std::size_t offset)
+{
+	for (std::size_t i = 0u; i < N; ++i)
+	{
+		v[i] = readings[(offset + i) & (bench_constants_t::readings - 1u)];
+	}
+}
+
+template <std::size_t N>
+std::uint16_t bench_nth_element(std::uint16_t (&v)[N])
+{
+	std::nth_element(v, v + (N / 2u), v + N);
+
+	return v[N / 2u];
+}
+
+void bench_set_rate(benchmark::State &state)
+{
+	const double medians = static_cast<double>(state.iterations());
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["time_per_median"] = benchmark::Counter(
+	    medians, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+template <std::size_t N>
+void BM_median_network(benchmark::State &state)
+{
+	const std::vector<std::uint16_t> readings = bench_readings();
+	std::size_t offset = 0u;
+
+	for (std::size_t i = 0u; i < bench_constants_t::readings; ++i)
+	{
+		std::uint16_t a[N];
+		std::uint16_t b[N];
+
+		bench_load(a, readings, i);
+		bench_load(b, readings, i);
+		if (sn2_median_select(a) != bench_nth_element(b))
+		{
+			state.SkipWithError("network median differs from std::nth_element");
+			return;
+		}
+	}
+
+	for (auto _ : state)
+	{
+		std::uint16_t v[N];
+
+		bench_load(v, readings, offset);
+		benchmark::DoNotOptimize(sn2_median_select(v));
+		offset = (offset + 1u) & (bench_constants_t::readings - 1u);
+	}
+	bench_set_rate(state);
+}
+BENCHMARK_TEMPLATE(BM_median_network, 3);
+BENCHMARK_TEMPLATE(BM_median_network, 5);
+BENCHMARK_TEMPLATE(BM_median_network, 7);
+BENCHMARK_TEMPLATE(BM_median_network, 9);
+
+template <std::size_t N>
+void BM_median_nth_element(benchmark::State &state)
+{
+	const std::vector<std::uint16_t> readings = bench_readings();
+	std::size_t offset = 0u;
+
+	for (auto _ : state)
+	{
+		std::uint16_t v[N];
+
+		bench_load(v, readings, offset);
+		benchmark::DoNotOptimize(bench_nth_element(v));
+		offset = (offset + 1u) & (bench_constants_t::readings - 1u);
+	}
+	bench_set_rate(state);
+}
+BENCHMARK_TEMPLATE(BM_median_nth_element, 3);
+BENCHMARK_TEMPLATE(BM_median_nth_element, 5);
+BENCHMARK_TEMPLATE(BM_median_nth_element, 7);
+BENCHMARK_TEMPLATE(BM_median_nth_element, 9);
+
+template <std::size_t N>
+void BM_median_running(benchmark::State &state)
+{
+	const std::vector<std::uint16_t> readings = bench_readings();
+	sn2_median_t<N> median;
+	std::size_t offset = 0u;
+
+	sn2_median_init(median);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(sn2_median_update(median, readings[offset]));
+		offset = (offset + 1u) & (bench_constants_t::readings - 1u);
+	}
+	bench_set_rate(state);
+}
+BENCHMARK_TEMPLATE(BM_median_running, 5);
+BENCHMARK_TEMPLATE(BM_median_running, 9);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,251 @@
+/**
+ * @file	sn2-timer-wheel-bench.cpp
+ * @brief	Google Benchmark suite for the timer wheel
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Times sn2_timer_wheel_run() of src/sn2-timer-wheel.hpp over a set of
+ * periodic timers advanced one millisecond per iteration, as loop()
+ * drives it, and the start/stop pair the application uses to re-arm a
+ * timer. Results report items/s (milliseconds or re-arms per second).
+ *
+ * Before timing, every benchmark checks the wheel against the cases a
+ * callback can create while its own slot is being dispatched, and fails
+ * on any mismatch:
+ *
+ * - stopping a timer due in the same millisecond that has not fired yet,
+ * - restarting such a timer for a later tick,
+ * - starting a timer into the same slot one rotation later, and
+ * - arming a timer for a tick the wheel has already processed.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/sn2-timer-wheel.hpp"
+
+namespace
+{
+
+/**
+ * @brief Benchmark sizing constants.
+ */
+struct bench_constants_t final
+{
+	static constexpr std::size_t timers = 64u;
+	static constexpr std::uint32_t period_min_ms = 10u;
+	static constexpr std::uint32_t period_span_ms = 1000u;
+	static constexpr std::uint32_t seed = 1u;
+};
+
+/**
+ * @brief Timer under check, with what its callback does to another.
+ */
+struct bench_probe_t final
+{
+	sn2_timer_wheel_t *wheel;
+	sn2_timer_t timer;
+	sn2_timer_t *target;
+	std::uint32_t target_expires_ms; /* 0 = stop target */
+	std::uint32_t fired;
+	std::uint32_t fired_ms;
+};
+
+void bench_probe_fn(void *context, sn2_timer_t &timer, std::uint32_t now_ms)
+{
+	bench_probe_t &probe = *static_cast<bench_probe_t *>(context);
+
+	(void)timer;
+	probe.fired += 1u;
+	probe.fired_ms = now_ms;
+	if (probe.target != nullptr)
+	{
+		if (probe.target_expires_ms == 0u)
+		{
+			sn2_timer_stop(*probe.wheel, *probe.target);
+		}
+		else
+		{
+			sn2_timer_start(*probe.wheel, *probe.target, probe.target_expires_ms, 0u);
+		}
+	}
+}
+
+void bench_probe_init(bench_probe_t &probe, sn2_timer_wheel_t &wheel)
+{
+	probe = bench_probe_t{};
+	probe.wheel = &wheel;
+	sn2_timer_init(probe.timer, bench_probe_fn, &probe);
+}
+
+void bench_run_to(sn2_timer_wheel_t &wheel, std::uint32_t from_ms, std::uint32_t to_ms)
+{
+	for (std::uint32_t now = from_ms; now != (to_ms + 1u); ++now)
+	{
+		(void)sn2_timer_wheel_run(wheel, now);
+	}
+}
+
+/**
+ * @brief Check dispatch while callbacks edit timers of the same slot.
+ * @return nullptr on success, else what went wrong.
+ */
+const char *bench_check_dispatch()
+{
+	const char *error = nullptr;
+	sn2_timer_wheel_t wheel;
+	bench_probe_t a;
+	bench_probe_t b;
+	bench_probe_t c;
+
+	/* A and B due at tick 20; A stops B; C later joins slot 20. */
+	sn2_timer_wheel_init(wheel, 0u);
+	bench_probe_init(a, wheel);
+	bench_probe_init(b, wheel);
+	bench_probe_init(c, wheel);
+	a.target = &b.timer;
+	sn2_timer_start(wheel, a.timer, 20u, 0u);
+	sn2_timer_start(wheel, b.timer, 20u, 0u);
+	bench_run_to(wheel, 0u, 20u);
+	sn2_timer_start(wheel, c.timer, 84u, 0u);
+	bench_run_to(wheel, 21u, 100u);
+	if ((a.fired != 1u) || (b.fired != 0u) || b.timer.armed || (c.fired != 1u) ||
+	    (c.fired_ms != 84u))
+	{
+		error = "stop from a callback: stopped timer fired or slot lost";
+	}
+
+	/* A restarts B (due with it) for tick 50; B fires once, at 50. */
+	sn2_timer_wheel_init(wheel, 0u);
+	bench_probe_init(a, wheel);
+	bench_probe_init(b, wheel);
+	a.target = &b.timer;
+	a.target_expires_ms = 50u;
+	sn2_timer_start(wheel, a.timer, 20u, 0u);
+	sn2_timer_start(wheel, b.timer, 20u, 0u);
+	bench_run_to(wheel, 0u, 100u);
+	if ((error == nullptr) && ((b.fired != 1u) || (b.fired_ms != 50u)))
+	{
+		error = "restart from a callback: timer fired early or not at all";
+	}
+
+	/* A (periodic, 10 ms) stops itself on the first call via B's slot. */
+	sn2_timer_wheel_init(wheel, 0u);
+	bench_probe_init(a, wheel);
+	bench_probe_init(b, wheel);
+	b.target = &a.timer;
+	sn2_timer_start(wheel, b.timer, 20u, 0u);
+	sn2_timer_start(wheel, a.timer, 20u, 10u);
+	bench_run_to(wheel, 0u, 100u);
+	if ((error == nullptr) && ((a.fired != 0u) || a.timer.armed))
+	{
+		error = "stop from a callback: periodic timer re-armed";
+	}
+
+	/* Armed for a processed tick: fires on the next run at the same time. */
+	sn2_timer_wheel_init(wheel, 0u);
+	bench_probe_init(a, wheel);
+	bench_run_to(wheel, 0u, 30u);
+	sn2_timer_start(wheel, a.timer, 30u, 0u);
+	(void)sn2_timer_wheel_run(wheel, 30u);
+	if ((error == nullptr) && (a.fired != 1u))
+	{
+		error = "overdue timer not dispatched";
+	}
+
+	return error;
+}
+
+void bench_tick_fn(void *context, sn2_timer_t &timer, std::uint32_t now_ms)
+{
+	(void)timer;
+	(void)now_ms;
+	*static_cast<std::uint32_t *>(context) += 1u;
+}
+
+/**
+ * @brief Periodic timers with pseudo-random periods.
+ */
+void bench_arm(sn2_timer_wheel_t &wheel, std::vector<sn2_timer_t> &timers,
+	       std::uint32_t &calls)
+{
+	std::uint32_t state = bench_constants_t::seed;
+
+	sn2_timer_wheel_init(wheel, 0u);
+	for (sn2_timer_t &timer : timers)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		const std::uint32_t period =
+		    bench_constants_t::period_min_ms + (state % bench_constants_t::period_span_ms);
+
+		sn2_timer_init(timer, bench_tick_fn, &calls);
+		sn2_timer_start(wheel, timer, period, period);
+	}
+}
+
+void BM_timer_wheel_run(benchmark::State &state)
+{
+	const char *error = bench_check_dispatch();
+
+	if (error != nullptr)
+	{
+		state.SkipWithError(error);
+		return;
+	}
+
+	sn2_timer_wheel_t wheel;
+	std::vector<sn2_timer_t> timers(bench_constants_t::timers);
+	std::uint32_t calls = 0u;
+	std::uint32_t now = 0u;
+
+	bench_arm(wheel, timers, calls);
+	for (auto _ : state)
+	{
+		++now;
+		benchmark::DoNotOptimize(sn2_timer_wheel_run(wheel, now));
+	}
+	benchmark::DoNotOptimize(calls);
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_timer_wheel_run);
+
+void BM_timer_wheel_rearm(benchmark::State &state)
+{
+	const char *error = bench_check_dispatch();
+
+	if (error != nullptr)
+	{
+		state.SkipWithError(error);
+		return;
+	}
+
+	sn2_timer_wheel_t wheel;
+	std::vector<sn2_timer_t> timers(bench_constants_t::timers);
+	std::uint32_t calls = 0u;
+	std::uint32_t offset = 0u;
+
+	bench_arm(wheel, timers, calls);
+	for (auto _ : state)
+	{
+		sn2_timer_t &timer = timers[offset % bench_constants_t::timers];
+
+		sn2_timer_stop(wheel, timer);
+		sn2_timer_start(wheel, timer, offset, 0u);
+		benchmark::DoNotOptimize(timer.armed);
+		offset = (offset * 1664525u) + 1013904223u;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_timer_wheel_rearm);
+
+} // namespace
+
+BENCHMARK_MAIN();
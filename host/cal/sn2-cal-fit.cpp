@@ -0,0 +1,271 @@
+/**
+ * @file	sn2-cal-fit.cpp
+ * @brief	Fit a per-board temperature calibration from reference points
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Reads calibration points, one per line as
+ *
+ *	<board centi-degrees> <reference centi-degrees>
+ *
+ * where the board value is the uncalibrated telemetry primary_value
+ * (identity calibration) and the reference is a trusted thermometer at
+ * the same moment. Blank lines and lines starting with '#' are ignored.
+ * The tool least-squares fits the correction (reference - board) as a
+ * polynomial and adds it to the identity of src/sn2-calibration.hpp, so
+ * one point gives an offset and two give offset and gain. It quantises
+ * the result and reports the residual of every point as the firmware
+ * computes it (sn2_calibration_apply()).
+ * It prints the argument for the firmware's "calibrate" cloud function
+ * and the 24-byte persistent record in hex.
+ *
+ * Usage:
+ *	sn2-cal-fit POINTS [--degree N]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../../src/sn2-calibration.hpp"
+
+namespace
+{
+
+/**
+ * @brief One calibration point.
+ */
+struct cal_point_t final
+{
+	std::int16_t board_centi;
+	std::int16_t reference_centi;
+};
+
+const char *cal_option(int argc, char **argv, const char *name,
+		       const char *fallback)
+{
+	const char *value = fallback;
+
+	for (int i = 2; (i + 1) < argc; ++i)
+	{
+		if (std::strcmp(argv[i], name) == 0)
+		{
+			value = argv[i + 1];
+		}
+	}
+
+	return value;
+}
+
+bool cal_read_points(const char *path, std::vector<cal_point_t> &points)
+{
+	std::FILE *file = std::fopen(path, "r");
+	char line[256];
+	bool ok = file != nullptr;
+
+	while (ok && (std::fgets(line, sizeof(line), file) != nullptr))
+	{
+		long board = 0;
+		long reference = 0;
+
+		if ((line[0] == '#') || (std::sscanf(line, "%ld %ld", &board, &reference) != 2))
+		{
+			continue;
+		}
+		ok = (board >= -32768) && (board <= 32767) && (reference >= -32768) &&
+		     (reference <= 32767);
+		if (ok)
+		{
+			points.push_back(cal_point_t{static_cast<std::int16_t>(board),
+						     static_cast<std::int16_t>(reference)});
+		}
+		else
+		{
+			std::fprintf(stderr, "sn2-cal-fit: value out of range: %s", line);
+		}
+	}
+	if (file != nullptr)
+	{
+		std::fclose(file);
+	}
+	else
+	{
+		std::perror(path);
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Least-squares fit of reference - board as a polynomial in
+ *	  u = board / 2^15, via the normal equations.
+ * @return false if the system is singular (too few distinct points).
+ */
+bool cal_fit(const std::vector<cal_point_t> &points, std::size_t degree,
+	     long double (&coeff)[sn2_calibration_constants_t::max_degree + 1u])
+{
+	constexpr std::size_t n_max = sn2_calibration_constants_t::max_degree + 1u;
+	const std::size_t n = degree + 1u;
+	long double a[n_max][n_max + 1u] = {};
+	bool ok = true;
+
+	for (const cal_point_t &p : points)
+	{
+		const long double u = static_cast<long double>(p.board_centi) / 32768.0L;
+		long double pow_u[2u * n_max] = {1.0L};
+
+		for (std::size_t k = 1u; k < (2u * n); ++k)
+		{
+			pow_u[k] = pow_u[k - 1u] * u;
+		}
+		for (std::size_t r = 0u; r < n; ++r)
+		{
+			for (std::size_t c = 0u; c < n; ++c)
+			{
+				a[r][c] += pow_u[r + c];
+			}
+			a[r][n] += pow_u[r] * static_cast<long double>(p.reference_centi -
+								       p.board_centi);
+		}
+	}
+
+	/* Gauss-Jordan elimination with partial pivoting. */
+	for (std::size_t col = 0u; ok && (col < n); ++col)
+	{
+		std::size_t pivot = col;
+
+		for (std::size_t r = col + 1u; r < n; ++r)
+		{
+			if (std::fabs(a[r][col]) > std::fabs(a[pivot][col]))
+			{
+				pivot = r;
+			}
+		}
+		ok = std::fabs(a[pivot][col]) > 1e-30L;
+		for (std::size_t c = 0u; ok && (c <= n); ++c)
+		{
+			const long double t = a[col][c];
+
+			a[col][c] = a[pivot][c];
+			a[pivot][c] = t;
+		}
+		for (std::size_t r = 0u; ok && (r < n); ++r)
+		{
+			const long double f = a[r][col] / a[col][col];
+
+			for (std::size_t c = col; (r != col) && (c <= n); ++c)
+			{
+				a[r][c] -= f * a[col][c];
+			}
+		}
+	}
+
+	for (std::size_t k = 0u; k < n_max; ++k)
+	{
+		coeff[k] = (ok && (k < n)) ? (a[k][n] / a[k][k]) : 0.0L;
+	}
+
+	return ok;
+}
+
+int cal_run(const char *path, long degree_arg)
+{
+	std::vector<cal_point_t> points;
+	long double coeff[sn2_calibration_constants_t::max_degree + 1u] = {};
+	sn2_calibration_t cal = sn2_calibration_identity();
+	std::uint8_t record[sn2_calibration_constants_t::record_size];
+	long worst = 0;
+	int rc = 1;
+
+	if (!cal_read_points(path, points) || points.empty())
+	{
+		std::fprintf(stderr, "sn2-cal-fit: no calibration points\n");
+		return rc;
+	}
+
+	/* Default: the highest degree the points support, at most 3. */
+	const std::size_t degree = static_cast<std::size_t>(
+	    (degree_arg >= 0) ? degree_arg
+			      : ((points.size() > sn2_calibration_constants_t::max_degree)
+				     ? static_cast<long>(sn2_calibration_constants_t::max_degree)
+				     : static_cast<long>(points.size()) - 1));
+
+	if ((degree > sn2_calibration_constants_t::max_degree) || (degree >= points.size()))
+	{
+		std::fprintf(stderr, "sn2-cal-fit: degree %zu needs at least %zu points (max 3)\n",
+			     degree, degree + 1u);
+		return rc;
+	}
+	if (!cal_fit(points, degree, coeff))
+	{
+		std::fprintf(stderr, "sn2-cal-fit: points do not determine a degree %zu fit\n",
+			     degree);
+		return rc;
+	}
+
+	/* The identity contributes 2^15 centi-degrees per unit of u. */
+	coeff[1] += 32768.0L;
+	cal.degree = static_cast<std::uint8_t>((degree > 1u) ? degree : 1u);
+	for (std::size_t k = 0u; k <= sn2_calibration_constants_t::max_degree; ++k)
+	{
+		const long double q = std::nearbyint(
+		    coeff[k] * static_cast<long double>(1L << sn2_calibration_constants_t::coeff_shift));
+
+		if ((q > 2147483647.0L) || (q < -2147483648.0L))
+		{
+			std::fprintf(stderr, "sn2-cal-fit: c%zu does not fit in Q15\n", k);
+			return rc;
+		}
+		cal.coeff[k] = static_cast<std::int32_t>(q);
+	}
+
+	std::printf("%8s %8s %8s %8s\n", "board", "ref", "fitted", "error");
+	for (const cal_point_t &p : points)
+	{
+		const std::int16_t fitted = sn2_calibration_apply(cal, p.board_centi);
+		const long error = static_cast<long>(fitted) - p.reference_centi;
+
+		worst = (std::labs(error) > worst) ? std::labs(error) : worst;
+		std::printf("%8d %8d %8d %8ld\n", p.board_centi, p.reference_centi, fitted, error);
+	}
+	std::printf("degree %zu, %zu points, worst error %ld centi-degrees\n", degree,
+		    points.size(), worst);
+
+	std::printf("calibrate \"%ld %ld %ld %ld\"\n", static_cast<long>(cal.coeff[0]),
+		    static_cast<long>(cal.coeff[1]), static_cast<long>(cal.coeff[2]),
+		    static_cast<long>(cal.coeff[3]));
+
+	sn2_calibration_pack(record, cal);
+	std::printf("record");
+	for (std::uint8_t b : record)
+	{
+		std::printf(" %02x", b);
+	}
+	std::printf("\n");
+	rc = 0;
+
+	return rc;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	int rc = 2;
+
+	if (argc >= 2)
+	{
+		rc = cal_run(argv[1], std::strtol(cal_option(argc, argv, "--degree", "-1"),
+						  nullptr, 10));
+	}
+	else
+	{
+		std::fprintf(stderr, "usage: %s POINTS [--degree N]\n", argv[0]);
+	}
+
+	return rc;
+}
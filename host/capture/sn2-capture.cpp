@@ -0,0 +1,337 @@
+/**
+ * @file	sn2-capture.cpp
+ * @brief	Record, replay and dump SN2 capture logs
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Commands:
+ *
+ * - record: bind the control node socket, append every received
+ *   simulator datagram to a capture file and optionally forward it to
+ *   the real control node, so the tool can sit transparently between
+ *   sn2-sim (or a BLE bridge) and cn-aggregator.
+ * - replay: send the frames of a capture to a control node socket,
+ *   preserving their relative timing scaled by --speed (0 = as fast as
+ *   possible). Trace records (kinds 0x80 and above, e.g. from a
+ *   sn2-replay trace) are not BLE traffic and are skipped.
+ * - dump: decode and print every frame; trace records are listed by
+ *   kind and length.
+ *
+ * Usage:
+ *	sn2-capture record FILE [--bind PATH] [--forward PATH]
+ *	sn2-capture replay FILE [--central PATH] [--speed X]
+ *	sn2-capture dump FILE
+ */
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#include "sn2-capture.hpp"
+
+namespace
+{
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void capture_on_signal(int)
+{
+	g_stop = 1;
+}
+
+bool capture_make_address(sockaddr_un &addr, const char *path)
+{
+	bool ok = true;
+
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (std::strlen(path) >= sizeof(addr.sun_path))
+	{
+		ok = false;
+	}
+	else
+	{
+		std::strcpy(addr.sun_path, path);
+	}
+
+	return ok;
+}
+
+const char *capture_option(int argc, char **argv, const char *name,
+			   const char *fallback)
+{
+	const char *value = fallback;
+
+	for (int i = 3; (i + 1) < argc; ++i)
+	{
+		if (std::strcmp(argv[i], name) == 0)
+		{
+			value = argv[i + 1];
+		}
+	}
+
+	return value;
+}
+
+int capture_record(const char *path, const char *bind_path,
+		   const char *forward_path)
+{
+	capture_writer_t writer{};
+	sockaddr_un local{};
+	sockaddr_un forward{};
+	const int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	const auto start = std::chrono::steady_clock::now();
+	const std::uint64_t start_unix_ms = static_cast<std::uint64_t>(
+	    std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::system_clock::now().time_since_epoch())
+		.count());
+
+	if ((fd < 0) || !capture_make_address(local, bind_path) ||
+	    ((forward_path != nullptr) &&
+	     !capture_make_address(forward, forward_path)) ||
+	    !capture_writer_open(writer, path, start_unix_ms))
+	{
+		std::fprintf(stderr, "sn2-capture: cannot open %s\n", path);
+		return 1;
+	}
+
+	/* An appended capture keeps its original start: offset this run. */
+	const std::uint64_t resume_us =
+	    (start_unix_ms > writer.start_unix_ms)
+		? ((start_unix_ms - writer.start_unix_ms) * 1000u)
+		: 0u;
+
+	unlink(bind_path);
+	if (bind(fd, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) != 0)
+	{
+		std::perror("sn2-capture: bind");
+		return 1;
+	}
+
+	timeval timeout{};
+	timeout.tv_usec = 100000;
+	(void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	while (g_stop == 0)
+	{
+		std::uint8_t datagram[sim_link_constants_t::datagram_max];
+		const ssize_t got = recv(fd, datagram, sizeof(datagram), 0);
+		std::uint16_t instance = 0u;
+		sim_characteristic_t characteristic = sim_characteristic_t::telemetry;
+		const std::uint8_t *payload = nullptr;
+		std::size_t payload_size = 0u;
+
+		if ((got > 0) &&
+		    sim_link_unwrap(datagram, static_cast<std::size_t>(got),
+				    instance, characteristic, payload,
+				    payload_size))
+		{
+			const std::uint64_t now_us =
+			    resume_us +
+			    static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::microseconds>(
+				    std::chrono::steady_clock::now() - start)
+				    .count());
+
+			(void)capture_writer_append(
+			    writer, now_us, instance,
+			    static_cast<std::uint8_t>(characteristic), payload,
+			    payload_size);
+			if (forward_path != nullptr)
+			{
+				(void)sendto(fd, datagram, static_cast<std::size_t>(got),
+					     0,
+					     reinterpret_cast<const sockaddr *>(&forward),
+					     sizeof(forward));
+			}
+		}
+	}
+
+	std::fprintf(stderr, "sn2-capture: %llu frames recorded\n",
+		     static_cast<unsigned long long>(writer.records));
+	capture_writer_close(writer);
+	close(fd);
+	unlink(bind_path);
+
+	return 0;
+}
+
+int capture_replay(const char *path, const char *central_path, double speed)
+{
+	capture_reader_t reader{};
+	sockaddr_un central{};
+	const int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	std::uint64_t sent = 0u;
+	std::uint64_t skipped = 0u;
+
+	if ((fd < 0) || !capture_make_address(central, central_path) ||
+	    !capture_reader_open(reader, path))
+	{
+		std::fprintf(stderr, "sn2-capture: cannot replay %s\n", path);
+		return 1;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	capture_frame_t frame{};
+
+	while ((g_stop == 0) && capture_reader_next(reader, frame))
+	{
+		if (!capture_kind_is_ble(frame.kind))
+		{
+			++skipped;
+			continue;
+		}
+
+		std::uint8_t datagram[sim_link_constants_t::datagram_max];
+		const std::size_t size = sim_link_wrap(
+		    datagram, sizeof(datagram), frame.instance,
+		    static_cast<sim_characteristic_t>(frame.kind), frame.payload,
+		    frame.length);
+
+		if (speed > 0.0)
+		{
+			const auto due =
+			    start + std::chrono::microseconds(static_cast<std::int64_t>(
+					static_cast<double>(frame.timestamp_us) / speed));
+
+			std::this_thread::sleep_until(due);
+		}
+
+		if ((size != 0u) &&
+		    (sendto(fd, datagram, size, 0,
+			    reinterpret_cast<const sockaddr *>(&central),
+			    sizeof(central)) == static_cast<ssize_t>(size)))
+		{
+			++sent;
+		}
+	}
+
+	const double secs = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start)
+				.count();
+
+	std::fprintf(stderr,
+		     "sn2-capture: %llu frames replayed in %.2f s "
+		     "(%.1f s of traffic, %llu trace records skipped)\n",
+		     static_cast<unsigned long long>(sent), secs,
+		     static_cast<double>(frame.timestamp_us) / 1.0e6,
+		     static_cast<unsigned long long>(skipped));
+	capture_reader_close(reader);
+	close(fd);
+
+	return 0;
+}
+
+int capture_dump(const char *path)
+{
+	capture_reader_t reader{};
+	capture_frame_t frame{};
+
+	if (!capture_reader_open(reader, path))
+	{
+		std::fprintf(stderr, "sn2-capture: %s is not a capture\n", path);
+		return 1;
+	}
+
+	std::printf("# format %u, protocol v%u, start %llu ms\n",
+		    reader.header.format_version, reader.header.protocol_version,
+		    static_cast<unsigned long long>(reader.header.start_unix_ms));
+	std::printf("# service %.36s\n", reader.header.uuids[0]);
+
+	while (capture_reader_next(reader, frame))
+	{
+		telemetry_view_t telem{nullptr};
+		event_view_t event{nullptr};
+		control_view_t ctrl{nullptr};
+		const sim_characteristic_t kind =
+		    static_cast<sim_characteristic_t>(frame.kind);
+
+		std::printf("%12.6f %5u ", static_cast<double>(frame.timestamp_us) / 1.0e6,
+			    frame.instance);
+		if ((kind == sim_characteristic_t::telemetry) &&
+		    ble_view_telemetry(telem, frame.payload, frame.length))
+		{
+			std::printf("telem node=%u flags=0x%04x primary=%d secondary=%d"
+				    " pot=%u duty=%u\n",
+				    telem.node_id(), telem.flags(),
+				    telem.primary_value(), telem.secondary_value(),
+				    telem.potentiometer_raw(), telem.duty_commanded());
+		}
+		else if ((kind == sim_characteristic_t::event) &&
+			 ble_view_event(event, frame.payload, frame.length))
+		{
+			std::printf("event node=%u type=%u value=%d ts=%u\n",
+				    event.node_id(), event.event_type(),
+				    event.event_value(), event.timestamp_ms_mod());
+		}
+		else if ((kind == sim_characteristic_t::control) &&
+			 ble_view_control(ctrl, frame.payload, frame.length))
+		{
+			std::printf("ctrl  target=%u flags=0x%04x duty=%u\n",
+				    ctrl.target_node_id(), ctrl.command_flags(),
+				    ctrl.duty_override());
+		}
+		else if (!capture_kind_is_ble(frame.kind))
+		{
+			std::printf("trace kind=0x%02x len=%zu\n", frame.kind, frame.length);
+		}
+		else
+		{
+			std::printf("kind=%u len=%zu\n", frame.kind, frame.length);
+		}
+	}
+
+	capture_reader_close(reader);
+
+	return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	int rc = 2;
+
+	std::signal(SIGINT, capture_on_signal);
+	std::signal(SIGTERM, capture_on_signal);
+
+	if ((argc >= 3) && (std::strcmp(argv[1], "record") == 0))
+	{
+		rc = capture_record(argv[2],
+				    capture_option(argc, argv, "--bind",
+						   "/tmp/sn2-cn.sock"),
+				    capture_option(argc, argv, "--forward", nullptr));
+	}
+	else if ((argc >= 3) && (std::strcmp(argv[1], "replay") == 0))
+	{
+		rc = capture_replay(argv[2],
+				    capture_option(argc, argv, "--central",
+						   "/tmp/sn2-cn.sock"),
+				    std::strtod(capture_option(argc, argv, "--speed",
+							       "1"),
+						nullptr));
+	}
+	else if ((argc >= 3) && (std::strcmp(argv[1], "dump") == 0))
+	{
+		rc = capture_dump(argv[2]);
+	}
+	else
+	{
+		std::fprintf(stderr,
+			     "usage: %s record FILE [--bind PATH] [--forward PATH]\n"
+			     "       %s replay FILE [--central PATH] [--speed X]\n"
+			     "       %s dump FILE\n",
+			     argv[0], argv[0], argv[0]);
+	}
+
+	return rc;
+}
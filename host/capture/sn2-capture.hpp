@@ -0,0 +1,461 @@
+/**
+ * @file	sn2-capture.hpp
+ * @brief	Append-only binary capture log of BLE frames with mmap replay
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Archives the raw characteristic payloads exchanged with sensor nodes
+ * so traffic can be replayed later for regression testing.
+ *
+ * File layout (all integers little-endian):
+ *
+ * - capture_file_header_t: magic, format version, header size, BLE
+ *   protocol version, capture start (wall clock) and the ASCII UUIDs
+ *   from ble_uuid_t, so a capture documents the contract it was taken
+ *   under.
+ * - A sequence of records, each a capture_record_header_t followed by
+ *   `length` payload bytes. timestamp_us is monotonic microseconds
+ *   since the start of the capture and never decreases.
+ *
+ * Records are written with one write() call each on a file opened for
+ * append, so a crash can only truncate the final record; readers stop
+ * at the first incomplete record. Reopening an existing capture for
+ * append validates its header, cuts such a torn record off and resumes
+ * the timeline after the last complete record. The reader maps the whole file and
+ * hands out pointers into the mapping, so iteration never copies
+ * payload bytes.
+ *
+ * Record kinds 1..0x7F mirror sim_characteristic_t; kinds 0x80 and
+ * above are reserved for non-BLE trace records.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../protocol/ble-protocol.hpp"
+#include "../sim/sn2-sim-link.hpp"
+
+/**
+ * @brief Capture format constants.
+ */
+struct capture_constants_t final
+{
+	static constexpr char magic[8] = {'S', 'N', '2', 'C', 'A', 'P', '\r', '\n'};
+	static constexpr std::uint16_t format_version = 1u;
+	static constexpr std::size_t uuid_chars = 36u;
+	static constexpr std::size_t uuid_count = 6u;
+	static constexpr std::size_t payload_max = 255u;
+	static constexpr std::uint8_t trace_kind_min = 0x80u; /* non-BLE records */
+};
+
+#pragma pack(push, 1)
+
+/**
+ * @brief Capture file header.
+ * @note uuids[] order: service, telemetry, event, control,
+ *	 telemetry_batch, telemetry_stream.
+ */
+struct capture_file_header_t final
+{
+	char magic[8];
+	std::uint16_t format_version;
+	std::uint16_t header_size;
+	std::uint8_t protocol_version;
+	std::uint8_t reserved[3];
+	std::uint64_t start_unix_ms;
+	char uuids[capture_constants_t::uuid_count]
+		  [capture_constants_t::uuid_chars];
+};
+
+/**
+ * @brief Header preceding every captured frame.
+ */
+struct capture_record_header_t final
+{
+	std::uint64_t timestamp_us;
+	std::uint16_t instance;
+	std::uint8_t kind;
+	std::uint8_t length;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(capture_file_header_t) == 240u,
+	      "capture_file_header_t size changed");
+static_assert(sizeof(capture_record_header_t) == 12u,
+	      "capture_record_header_t size changed");
+
+/**
+ * @brief One frame handed out by the reader (points into the mapping).
+ */
+struct capture_frame_t final
+{
+	std::uint64_t timestamp_us;
+	std::uint16_t instance;
+	std::uint8_t kind;
+	const std::uint8_t *payload;
+	std::size_t length;
+};
+
+/**
+ * @brief Append-only capture writer.
+ */
+struct capture_writer_t final
+{
+	int fd;
+	std::uint64_t start_unix_ms; /* from the file header */
+	std::uint64_t last_timestamp_us;
+	std::uint64_t records;
+};
+
+/**
+ * @brief Memory-mapped capture reader.
+ */
+struct capture_reader_t final
+{
+	const std::uint8_t *base;
+	std::size_t size;
+	std::size_t offset;
+	capture_file_header_t header;
+};
+
+/**
+ * @brief Whether a record kind is a BLE frame (not a trace record).
+ */
+static inline bool capture_kind_is_ble(std::uint8_t kind)
+{
+	return kind < capture_constants_t::trace_kind_min;
+}
+
+/**
+ * @brief Fill a header describing the current protocol contract.
+ * @param header Header to fill.
+ * @param start_unix_ms Wall-clock capture start.
+ */
+static inline void capture_make_header(capture_file_header_t &header,
+				       std::uint64_t start_unix_ms)
+{
+	const char *const uuids[capture_constants_t::uuid_count] = {
+	    ble_uuid_t::service, ble_uuid_t::telemetry,
+	    ble_uuid_t::event, ble_uuid_t::control,
+	    ble_uuid_t::telemetry_batch, ble_uuid_t::telemetry_stream};
+
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, capture_constants_t::magic,
+		    sizeof(header.magic));
+	header.format_version = capture_constants_t::format_version;
+	header.header_size = static_cast<std::uint16_t>(sizeof(header));
+	header.protocol_version =
+	    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
+	header.start_unix_ms = start_unix_ms;
+	for (std::size_t i = 0u; i < capture_constants_t::uuid_count; ++i)
+	{
+		std::memcpy(header.uuids[i], uuids[i],
+			    capture_constants_t::uuid_chars);
+	}
+}
+
+/**
+ * @brief Serialise a file header with explicit little-endian fields.
+ */
+static inline void capture_encode_header(std::uint8_t *dst,
+					 const capture_file_header_t &header)
+{
+	std::memcpy(dst, &header, sizeof(header));
+	ble_store_le<std::uint16_t>(
+	    dst + offsetof(capture_file_header_t, format_version),
+	    header.format_version);
+	ble_store_le<std::uint16_t>(
+	    dst + offsetof(capture_file_header_t, header_size),
+	    header.header_size);
+	ble_store_le<std::uint64_t>(
+	    dst + offsetof(capture_file_header_t, start_unix_ms),
+	    header.start_unix_ms);
+}
+
+/**
+ * @brief Map a capture file and validate its header.
+ * @param reader Reader to initialise.
+ * @param path File path.
+ * @return true if the file is a supported capture, otherwise false.
+ */
+static inline bool capture_reader_open(capture_reader_t &reader,
+				       const char *path)
+{
+	bool ok = true;
+	struct stat st{};
+	const int fd = open(path, O_RDONLY);
+
+	reader.base = nullptr;
+	reader.size = 0u;
+	reader.offset = 0u;
+
+	if ((fd < 0) || (fstat(fd, &st) != 0) ||
+	    (static_cast<std::size_t>(st.st_size) < sizeof(capture_file_header_t)))
+	{
+		ok = false;
+	}
+	else
+	{
+		void *map = mmap(nullptr, static_cast<std::size_t>(st.st_size),
+				 PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (map == MAP_FAILED)
+		{
+			ok = false;
+		}
+		else
+		{
+			reader.base = static_cast<const std::uint8_t *>(map);
+			reader.size = static_cast<std::size_t>(st.st_size);
+			(void)madvise(map, reader.size, MADV_SEQUENTIAL);
+
+			std::memcpy(&reader.header, reader.base,
+				    sizeof(reader.header));
+			reader.header.format_version = ble_load_le<std::uint16_t>(
+			    reader.base +
+			    offsetof(capture_file_header_t, format_version));
+			reader.header.header_size = ble_load_le<std::uint16_t>(
+			    reader.base + offsetof(capture_file_header_t, header_size));
+			reader.header.start_unix_ms = ble_load_le<std::uint64_t>(
+			    reader.base +
+			    offsetof(capture_file_header_t, start_unix_ms));
+
+			ok = (std::memcmp(reader.header.magic,
+					  capture_constants_t::magic,
+					  sizeof(reader.header.magic)) == 0) &&
+			     (reader.header.format_version ==
+			      capture_constants_t::format_version) &&
+			     (reader.header.header_size >=
+			      sizeof(capture_file_header_t)) &&
+			     (reader.header.header_size <= reader.size);
+			reader.offset = reader.header.header_size;
+		}
+	}
+
+	if (fd >= 0)
+	{
+		(void)close(fd);
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Advance to the next complete frame.
+ * @param reader Open reader.
+ * @param frame Frame pointing into the mapping.
+ * @return true if a frame was produced, false at end of data.
+ */
+static inline bool capture_reader_next(capture_reader_t &reader,
+				       capture_frame_t &frame)
+{
+	bool ok = false;
+
+	if ((reader.base != nullptr) &&
+	    ((reader.offset + sizeof(capture_record_header_t)) <= reader.size))
+	{
+		const std::uint8_t *rec = reader.base + reader.offset;
+		const std::size_t length =
+		    rec[offsetof(capture_record_header_t, length)];
+		const std::size_t size = sizeof(capture_record_header_t) + length;
+
+		if ((reader.offset + size) <= reader.size)
+		{
+			frame.timestamp_us = ble_load_le<std::uint64_t>(
+			    rec + offsetof(capture_record_header_t, timestamp_us));
+			frame.instance = ble_load_le<std::uint16_t>(
+			    rec + offsetof(capture_record_header_t, instance));
+			frame.kind = rec[offsetof(capture_record_header_t, kind)];
+			frame.payload = rec + sizeof(capture_record_header_t);
+			frame.length = length;
+			reader.offset += size;
+			ok = true;
+		}
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Restart iteration at the first frame.
+ */
+static inline void capture_reader_rewind(capture_reader_t &reader)
+{
+	reader.offset = reader.header.header_size;
+}
+
+/**
+ * @brief Unmap a capture file.
+ */
+static inline void capture_reader_close(capture_reader_t &reader)
+{
+	if (reader.base != nullptr)
+	{
+		(void)munmap(const_cast<std::uint8_t *>(reader.base), reader.size);
+		reader.base = nullptr;
+		reader.size = 0u;
+	}
+}
+
+/**
+ * @brief Prepare an existing capture for appending.
+ * @param writer Writer with fd open on path.
+ * @param path File path.
+ * @return false if the file is not a supported capture.
+ * @note Truncates an incomplete final record and takes start_unix_ms and
+ *	 last_timestamp_us from the file.
+ */
+static inline bool capture_writer_resume(capture_writer_t &writer, const char *path)
+{
+	capture_reader_t reader{};
+	capture_frame_t frame{};
+	bool ok = capture_reader_open(reader, path);
+
+	if (ok)
+	{
+		writer.start_unix_ms = reader.header.start_unix_ms;
+		while (capture_reader_next(reader, frame))
+		{
+			writer.last_timestamp_us = frame.timestamp_us;
+		}
+		if (reader.offset < reader.size)
+		{
+			ok = ftruncate(writer.fd, static_cast<off_t>(reader.offset)) == 0;
+		}
+	}
+	capture_reader_close(reader);
+
+	return ok;
+}
+
+/**
+ * @brief Open (or create) a capture file for appending.
+ * @param writer Writer to initialise.
+ * @param path File path.
+ * @param start_unix_ms Wall-clock start stored if the file is new.
+ * @return true if the file is ready, otherwise false (including an
+ *	   existing file that is not a capture).
+ * @note Appending to an existing capture continues its timeline:
+ *	 timestamps are relative to writer.start_unix_ms, the original
+ *	 start, not to start_unix_ms.
+ */
+static inline bool capture_writer_open(capture_writer_t &writer,
+				       const char *path,
+				       std::uint64_t start_unix_ms)
+{
+	bool ok = true;
+	struct stat st{};
+
+	writer.fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+	writer.start_unix_ms = start_unix_ms;
+	writer.last_timestamp_us = 0u;
+	writer.records = 0u;
+
+	if ((writer.fd < 0) || (fstat(writer.fd, &st) != 0))
+	{
+		ok = false;
+	}
+	else if (st.st_size == 0)
+	{
+		capture_file_header_t header{};
+		std::uint8_t bytes[sizeof(capture_file_header_t)];
+
+		capture_make_header(header, start_unix_ms);
+		capture_encode_header(bytes, header);
+		ok = write(writer.fd, bytes, sizeof(bytes)) ==
+		     static_cast<ssize_t>(sizeof(bytes));
+	}
+	else
+	{
+		ok = capture_writer_resume(writer, path);
+	}
+
+	if (!ok && (writer.fd >= 0))
+	{
+		(void)close(writer.fd);
+		writer.fd = -1;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Append one frame.
+ * @param writer Open writer.
+ * @param timestamp_us Monotonic time since capture start.
+ * @param instance Link instance of the node.
+ * @param kind Record kind (sim_characteristic_t value).
+ * @param payload Payload bytes.
+ * @param length Payload size in bytes (<= 255).
+ * @return true if written, otherwise false.
+ */
+static inline bool capture_writer_append(capture_writer_t &writer,
+					 std::uint64_t timestamp_us,
+					 std::uint16_t instance,
+					 std::uint8_t kind,
+					 const std::uint8_t *payload,
+					 std::size_t length)
+{
+	bool ok = true;
+	std::uint8_t record[sizeof(capture_record_header_t) +
+			    capture_constants_t::payload_max];
+
+	if ((writer.fd < 0) || (payload == nullptr) ||
+	    (length > capture_constants_t::payload_max))
+	{
+		ok = false;
+	}
+	else
+	{
+		/* Keep the timeline monotonic even if the caller's clock is not. */
+		if (timestamp_us < writer.last_timestamp_us)
+		{
+			timestamp_us = writer.last_timestamp_us;
+		}
+
+		ble_store_le<std::uint64_t>(
+		    record + offsetof(capture_record_header_t, timestamp_us),
+		    timestamp_us);
+		ble_store_le<std::uint16_t>(
+		    record + offsetof(capture_record_header_t, instance), instance);
+		record[offsetof(capture_record_header_t, kind)] = kind;
+		record[offsetof(capture_record_header_t, length)] =
+		    static_cast<std::uint8_t>(length);
+		std::memcpy(record + sizeof(capture_record_header_t), payload,
+			    length);
+
+		const std::size_t size = sizeof(capture_record_header_t) + length;
+
+		ok = write(writer.fd, record, size) == static_cast<ssize_t>(size);
+		if (ok)
+		{
+			writer.last_timestamp_us = timestamp_us;
+			++writer.records;
+		}
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Close a capture writer.
+ */
+static inline void capture_writer_close(capture_writer_t &writer)
+{
+	if (writer.fd >= 0)
+	{
+		(void)close(writer.fd);
+		writer.fd = -1;
+	}
+}
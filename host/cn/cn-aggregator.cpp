@@ -0,0 +1,377 @@
+/**
+ * @file	cn-aggregator.cpp
+ * @brief	Host control node aggregator and ingest throughput benchmark
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Two modes:
+ *
+ * - Socket mode (default): receives simulator datagrams (see
+ *   sn2-sim-link.hpp) on a UNIX socket in a receive thread, pushes them
+ *   through the MPSC ring, and aggregates them on the main thread,
+ *   printing fleet statistics once per second.
+ * - Bench mode (--bench): producer threads push pre-encoded telemetry
+ *   and event frames for many nodes as fast as they can while the main
+ *   thread drains and decodes, reporting packets per second for the
+ *   single aggregation core. A ring-free decode-only figure is printed
+ *   first as the upper bound.
+ *
+ * Usage:
+ *	cn-aggregator [--bind PATH]
+ *	cn-aggregator --bench [--producers N] [--packets N] [--nodes N]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "cn-aggregator.hpp"
+
+namespace
+{
+
+/**
+ * @brief Command-line options.
+ */
+struct cn_options_t final
+{
+	bool bench;
+	const char *bind_path;
+	std::size_t producers;
+	std::size_t packets;
+	std::size_t nodes;
+};
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void cn_on_signal(int)
+{
+	g_stop = 1;
+}
+
+double cn_seconds_since(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+					     start)
+	    .count();
+}
+
+bool cn_parse_options(int argc, char **argv, cn_options_t &opt)
+{
+	bool ok = true;
+
+	opt.bench = false;
+	opt.bind_path = "/tmp/sn2-cn.sock";
+	opt.producers = 2u;
+	opt.packets = 10000000u;
+	opt.nodes = 1000u;
+
+	for (int i = 1; ok && (i < argc); ++i)
+	{
+		const bool has_value = (i + 1) < argc;
+
+		if (std::strcmp(argv[i], "--bench") == 0)
+		{
+			opt.bench = true;
+		}
+		else if (has_value && (std::strcmp(argv[i], "--bind") == 0))
+		{
+			opt.bind_path = argv[++i];
+		}
+		else if (has_value && (std::strcmp(argv[i], "--producers") == 0))
+		{
+			opt.producers = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if (has_value && (std::strcmp(argv[i], "--packets") == 0))
+		{
+			opt.packets = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if (has_value && (std::strcmp(argv[i], "--nodes") == 0))
+		{
+			opt.nodes = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			ok = false;
+		}
+	}
+
+	if ((opt.producers == 0u) || (opt.nodes == 0u) ||
+	    (opt.nodes > cn_table_constants_t::nodes_max))
+	{
+		ok = false;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Pre-encode a mix of telemetry (15/16) and event (1/16) frames.
+ */
+std::vector<cn_frame_t> cn_make_frames(std::size_t nodes, std::size_t count)
+{
+	std::vector<cn_frame_t> frames(count);
+
+	for (std::size_t i = 0u; i < count; ++i)
+	{
+		const std::uint16_t instance =
+		    static_cast<std::uint16_t>(i % nodes);
+
+		if ((i & 15u) == 15u)
+		{
+			const event_packet_t pkt = ble_make_event(
+			    ble_node_id_t::sn2, ble_event_type_t::sound_detected,
+			    static_cast<std::int16_t>(i & 0x7FFu),
+			    static_cast<std::uint16_t>(i));
+			std::uint8_t buf[sizeof(event_packet_t)];
+
+			(void)ble_pack_event(buf, sizeof(buf), pkt);
+			(void)cn_frame_make(frames[i], instance,
+					    sim_characteristic_t::event, buf,
+					    sizeof(buf));
+		}
+		else
+		{
+			telemetry_packet_t pkt = ble_make_telemetry(ble_node_id_t::sn2);
+			std::uint8_t buf[sizeof(telemetry_packet_t)];
+
+			pkt.primary_value = static_cast<std::int16_t>(2000 + (i % 500u));
+			pkt.secondary_value = static_cast<std::int16_t>(i & 1u);
+			pkt.potentiometer_raw = static_cast<std::uint16_t>(i & 0xFFFu);
+			pkt.duty_commanded = static_cast<std::uint16_t>(i % 1001u);
+			(void)ble_pack_telemetry(buf, sizeof(buf), pkt);
+			(void)cn_frame_make(frames[i], instance,
+					    sim_characteristic_t::telemetry, buf,
+					    sizeof(buf));
+		}
+	}
+
+	return frames;
+}
+
+int cn_run_bench(const cn_options_t &opt)
+{
+	std::unique_ptr<cn_ring_t> ring(new cn_ring_t);
+	std::unique_ptr<cn_node_table_t> table(new cn_node_table_t);
+	const std::vector<cn_frame_t> frames = cn_make_frames(opt.nodes, 4096u);
+	std::atomic<bool> go{false};
+	std::vector<std::thread> producers;
+	std::size_t consumed = 0u;
+
+	cn_mpsc_ring_init(*ring);
+	cn_node_table_init(*table);
+
+	/* Upper bound: decode straight from memory, no ring. */
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		for (std::size_t i = 0u; i < opt.packets; ++i)
+		{
+			(void)cn_ingest_frame(*table, frames[i & 4095u]);
+		}
+
+		const double secs = cn_seconds_since(start);
+
+		std::printf("decode only : %12.0f packets/s (%.1f ns/packet)\n",
+			    static_cast<double>(opt.packets) / secs,
+			    (secs * 1.0e9) / static_cast<double>(opt.packets));
+	}
+
+	cn_node_table_init(*table);
+
+	for (std::size_t p = 0u; p < opt.producers; ++p)
+	{
+		const std::size_t share = (opt.packets / opt.producers) +
+					  ((p == 0u) ? (opt.packets % opt.producers)
+						     : 0u);
+
+		producers.emplace_back([&, p, share]() {
+			while (!go.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+			for (std::size_t i = 0u; i < share; ++i)
+			{
+				const cn_frame_t &frame = frames[(i + (p * 977u)) & 4095u];
+
+				while (!cn_mpsc_ring_push(*ring, frame))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	go.store(true, std::memory_order_release);
+	while (consumed < opt.packets)
+	{
+		const std::size_t n = cn_drain(*ring, *table);
+
+		consumed += n;
+		if (n == 0u)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	const double secs = cn_seconds_since(start);
+
+	for (std::thread &t : producers)
+	{
+		t.join();
+	}
+
+	std::printf("ring + decode: %12.0f packets/s (%zu producers, %zu nodes,"
+		    " %llu rejected)\n",
+		    static_cast<double>(consumed) / secs, opt.producers,
+		    table->active_nodes,
+		    static_cast<unsigned long long>(table->rejected_frames));
+
+	return 0;
+}
+
+int cn_run_socket(const cn_options_t &opt)
+{
+	std::unique_ptr<cn_ring_t> ring(new cn_ring_t);
+	std::unique_ptr<cn_node_table_t> table(new cn_node_table_t);
+	std::atomic<std::uint64_t> dropped{0u};
+	sockaddr_un addr{};
+	int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+
+	cn_mpsc_ring_init(*ring);
+	cn_node_table_init(*table);
+
+	addr.sun_family = AF_UNIX;
+	if ((fd < 0) || (std::strlen(opt.bind_path) >= sizeof(addr.sun_path)))
+	{
+		std::fprintf(stderr, "cn-aggregator: bad socket path\n");
+		return 1;
+	}
+	std::strcpy(addr.sun_path, opt.bind_path);
+	unlink(opt.bind_path);
+	if (bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0)
+	{
+		std::perror("cn-aggregator: bind");
+		return 1;
+	}
+
+	/* Wake the receive thread periodically so it can observe g_stop. */
+	timeval timeout{};
+	timeout.tv_usec = 100000;
+	(void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	std::thread receiver([&]() {
+		std::uint8_t datagram[sim_link_constants_t::datagram_max];
+
+		while (g_stop == 0)
+		{
+			const ssize_t got = recv(fd, datagram, sizeof(datagram), 0);
+			std::uint16_t instance = 0u;
+			sim_characteristic_t characteristic =
+			    sim_characteristic_t::telemetry;
+			const std::uint8_t *payload = nullptr;
+			std::size_t payload_size = 0u;
+			cn_frame_t frame{};
+
+			if ((got > 0) &&
+			    sim_link_unwrap(datagram, static_cast<std::size_t>(got),
+					    instance, characteristic, payload,
+					    payload_size) &&
+			    cn_frame_make(frame, instance, characteristic, payload,
+					  payload_size))
+			{
+				while (!cn_mpsc_ring_push(*ring, frame) && (g_stop == 0))
+				{
+					std::this_thread::yield();
+				}
+			}
+			else if (got > 0)
+			{
+				dropped.fetch_add(1u, std::memory_order_relaxed);
+			}
+		}
+	});
+
+	std::uint64_t total = 0u;
+	std::uint64_t last_total = 0u;
+	auto last_report = std::chrono::steady_clock::now();
+
+	while (g_stop == 0)
+	{
+		const std::size_t n = cn_drain(*ring, *table);
+
+		total += n;
+		if (n == 0u)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+
+		const double secs = cn_seconds_since(last_report);
+
+		if (secs >= 1.0)
+		{
+			std::printf("cn: %8.0f packets/s, %zu nodes, %zu help active,"
+				    " %llu rejected, %llu dropped\n",
+				    static_cast<double>(total - last_total) / secs,
+				    table->active_nodes,
+				    cn_node_table_help_count(*table),
+				    static_cast<unsigned long long>(
+					table->rejected_frames),
+				    static_cast<unsigned long long>(dropped.load()));
+			std::fflush(stdout);
+			last_total = total;
+			last_report = std::chrono::steady_clock::now();
+		}
+	}
+
+	receiver.join();
+	total += cn_drain(*ring, *table);
+	std::printf("cn: %llu packets total\n",
+		    static_cast<unsigned long long>(total));
+
+	close(fd);
+	unlink(opt.bind_path);
+
+	return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	cn_options_t opt{};
+	int rc = 0;
+
+	if (!cn_parse_options(argc, argv, opt))
+	{
+		std::fprintf(stderr,
+			     "usage: %s [--bind PATH]\n"
+			     "       %s --bench [--producers N] [--packets N]"
+			     " [--nodes N]\n",
+			     argv[0], argv[0]);
+		rc = 2;
+	}
+	else
+	{
+		std::signal(SIGINT, cn_on_signal);
+		std::signal(SIGTERM, cn_on_signal);
+		rc = opt.bench ? cn_run_bench(opt) : cn_run_socket(opt);
+	}
+
+	return rc;
+}
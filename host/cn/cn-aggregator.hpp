@@ -0,0 +1,145 @@
+/**
+ * @file	cn-aggregator.hpp
+ * @brief	Host control node ingest path: ring frames -> node table
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Receive threads wrap each notification in a cn_frame_t and push it
+ * into the MPSC ring; the aggregation thread drains the ring, decodes
+ * each frame with the protocol unpack helpers and updates the
+ * struct-of-arrays node table. Frames are sized to fill one 64-byte
+ * ring slot including its sequence number.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../../protocol/ble-protocol.hpp"
+#include "../sim/sn2-sim-link.hpp"
+#include "cn-mpsc-ring.hpp"
+#include "cn-node-table.hpp"
+
+/**
+ * @brief Aggregator sizing constants.
+ */
+struct cn_constants_t final
+{
+	static constexpr std::size_t frame_bytes_max = 48u;
+	static constexpr std::size_t ring_capacity = 65536u;
+};
+
+/**
+ * @brief One received characteristic payload.
+ */
+struct cn_frame_t final
+{
+	std::uint16_t instance;
+	sim_characteristic_t characteristic;
+	std::uint8_t size;
+	std::uint8_t bytes[cn_constants_t::frame_bytes_max];
+};
+
+using cn_ring_t = cn_mpsc_ring_t<cn_frame_t, cn_constants_t::ring_capacity>;
+
+static_assert(sizeof(cn_ring_t::slot_t) == 64u,
+	      "cn_frame_t no longer fits a single cache line slot");
+
+/**
+ * @brief Build a frame from a characteristic payload.
+ * @param dst Destination frame.
+ * @param instance Link instance of the sender.
+ * @param characteristic Characteristic the payload arrived on.
+ * @param payload Payload bytes.
+ * @param payload_size Payload size in bytes.
+ * @return true if the payload fits a frame, otherwise false.
+ */
+static inline bool cn_frame_make(
+    cn_frame_t &dst,
+    std::uint16_t instance,
+    sim_characteristic_t characteristic,
+    const std::uint8_t *payload,
+    std::size_t payload_size)
+{
+	bool ok = true;
+
+	if ((payload == nullptr) ||
+	    (payload_size > cn_constants_t::frame_bytes_max))
+	{
+		ok = false;
+	}
+	else
+	{
+		dst.instance = instance;
+		dst.characteristic = characteristic;
+		dst.size = static_cast<std::uint8_t>(payload_size);
+		std::memcpy(dst.bytes, payload, payload_size);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Decode one frame into the node table.
+ * @param table Table to update.
+ * @param frame Frame to decode.
+ * @return true if the frame was a valid telemetry or event packet.
+ */
+static inline bool cn_ingest_frame(cn_node_table_t &table,
+				   const cn_frame_t &frame)
+{
+	bool ok = false;
+
+	if (frame.characteristic == sim_characteristic_t::telemetry)
+	{
+		telemetry_packet_t pkt{};
+
+		ok = ble_unpack_telemetry(pkt, frame.bytes, frame.size);
+		if (ok)
+		{
+			cn_node_table_store_telemetry(table, frame.instance, pkt);
+		}
+	}
+	else if (frame.characteristic == sim_characteristic_t::event)
+	{
+		event_packet_t pkt{};
+
+		ok = ble_unpack_event(pkt, frame.bytes, frame.size);
+		if (ok)
+		{
+			cn_node_table_store_event(table, frame.instance, pkt);
+		}
+	}
+
+	if (!ok)
+	{
+		++table.rejected_frames;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Drain every frame currently queued in the ring.
+ * @param ring Ring to drain (consumer side).
+ * @param table Table to update.
+ * @return Number of frames consumed.
+ */
+static inline std::size_t cn_drain(cn_ring_t &ring, cn_node_table_t &table)
+{
+	std::size_t count = 0u;
+	cn_frame_t frame{};
+
+	while (cn_mpsc_ring_pop(ring, frame))
+	{
+		(void)cn_ingest_frame(table, frame);
+		++count;
+	}
+
+	return count;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file	cn-mpsc-ring.hpp
+ * @brief	Bounded lock-free multi-producer/single-consumer ring buffer
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Fixed-capacity ring used by the host control node to hand received
+ * frames from any number of ingest threads to one aggregation thread.
+ * Each slot carries a sequence number (Vyukov's bounded queue scheme):
+ * producers claim a position with one CAS on the shared head and then
+ * publish the slot with a release store; the single consumer never
+ * touches shared atomics other than the slot it is reading, so the
+ * consumer side is wait-free. Slots are cache-line aligned so
+ * producers writing adjacent slots do not false-share.
+ *
+ * No dynamic memory is used; the ring is a plain object sized at
+ * compile time.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Bounded MPSC ring of trivially copyable items.
+ * @tparam T Item type (copied in and out).
+ * @tparam Capacity Number of slots, a power of two.
+ * @note Call cn_mpsc_ring_init() before first use.
+ */
+template <typename T, std::size_t Capacity>
+struct cn_mpsc_ring_t final
+{
+	static_assert((Capacity >= 2u) && ((Capacity & (Capacity - 1u)) == 0u),
+		      "cn_mpsc_ring_t capacity must be a power of two");
+
+	static constexpr std::size_t capacity = Capacity;
+	static constexpr std::size_t mask = Capacity - 1u;
+
+	struct alignas(64) slot_t final
+	{
+		std::atomic<std::size_t> sequence;
+		T item;
+	};
+
+	slot_t slots[Capacity];
+	alignas(64) std::atomic<std::size_t> head;
+	alignas(64) std::size_t tail;
+};
+
+/**
+ * @brief Initialise an empty ring.
+ * @param ring Ring to initialise (must not be in use).
+ */
+template <typename T, std::size_t Capacity>
+static inline void cn_mpsc_ring_init(cn_mpsc_ring_t<T, Capacity> &ring)
+{
+	for (std::size_t i = 0u; i < Capacity; ++i)
+	{
+		ring.slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	ring.head.store(0u, std::memory_order_relaxed);
+	ring.tail = 0u;
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+/**
+ * @brief Push an item (any thread).
+ * @param ring Target ring.
+ * @param item Item to copy in.
+ * @return true if queued, false if the ring is full.
+ */
+template <typename T, std::size_t Capacity>
+static inline bool cn_mpsc_ring_push(cn_mpsc_ring_t<T, Capacity> &ring,
+				     const T &item)
+{
+	bool ok = false;
+	bool done = false;
+	std::size_t pos = ring.head.load(std::memory_order_relaxed);
+	typename cn_mpsc_ring_t<T, Capacity>::slot_t *slot = nullptr;
+
+	while (!done)
+	{
+		slot = &ring.slots[pos & cn_mpsc_ring_t<T, Capacity>::mask];
+
+		const std::size_t seq =
+		    slot->sequence.load(std::memory_order_acquire);
+		const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) -
+					    static_cast<std::ptrdiff_t>(pos);
+
+		if (diff == 0)
+		{
+			/* Slot free for this lap: try to claim it. */
+			if (ring.head.compare_exchange_weak(
+				pos, pos + 1u, std::memory_order_relaxed))
+			{
+				ok = true;
+				done = true;
+			}
+		}
+		else if (diff < 0)
+		{
+			/* Consumer has not freed this slot yet: full. */
+			ok = false;
+			done = true;
+		}
+		else
+		{
+			/* Another producer claimed it; reload and retry. */
+			pos = ring.head.load(std::memory_order_relaxed);
+		}
+	}
+
+	if (ok)
+	{
+		slot->item = item;
+		slot->sequence.store(pos + 1u, std::memory_order_release);
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Pop an item (consumer thread only).
+ * @param ring Source ring.
+ * @param item Destination for the item.
+ * @return true if an item was removed, false if the ring is empty.
+ */
+template <typename T, std::size_t Capacity>
+static inline bool cn_mpsc_ring_pop(cn_mpsc_ring_t<T, Capacity> &ring,
+				    T &item)
+{
+	bool ok = false;
+	typename cn_mpsc_ring_t<T, Capacity>::slot_t &slot =
+	    ring.slots[ring.tail & cn_mpsc_ring_t<T, Capacity>::mask];
+
+	if (slot.sequence.load(std::memory_order_acquire) == (ring.tail + 1u))
+	{
+		item = slot.item;
+		slot.sequence.store(ring.tail + Capacity,
+				    std::memory_order_release);
+		++ring.tail;
+		ok = true;
+	}
+
+	return ok;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file	cn-node-table.hpp
+ * @brief	Struct-of-arrays latest-state table for the host control node
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Holds the most recent telemetry and event state of every peripheral
+ * the control node has heard from, indexed by link instance. Each field
+ * lives in its own contiguous array so fleet-wide scans (e.g. "any help
+ * request active", "hottest node") stream through one array instead of
+ * striding across whole records.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../../protocol/ble-protocol.hpp"
+
+/**
+ * @brief Control node table limits.
+ */
+struct cn_table_constants_t final
+{
+	static constexpr std::size_t nodes_max = 65536u;
+};
+
+/**
+ * @brief Latest per-node state, struct-of-arrays layout.
+ */
+struct cn_node_table_t final
+{
+	/* Telemetry (telemetry_packet_t fields). */
+	std::uint8_t node_id[cn_table_constants_t::nodes_max];
+	std::uint16_t flags[cn_table_constants_t::nodes_max];
+	std::int16_t primary_value[cn_table_constants_t::nodes_max];
+	std::int16_t secondary_value[cn_table_constants_t::nodes_max];
+	std::uint16_t potentiometer_raw[cn_table_constants_t::nodes_max];
+	std::uint16_t duty_commanded[cn_table_constants_t::nodes_max];
+	std::uint32_t telemetry_count[cn_table_constants_t::nodes_max];
+
+	/* Most recent event (event_packet_t fields). */
+	std::uint8_t last_event_type[cn_table_constants_t::nodes_max];
+	std::int16_t last_event_value[cn_table_constants_t::nodes_max];
+	std::uint16_t last_event_timestamp[cn_table_constants_t::nodes_max];
+	std::uint32_t event_count[cn_table_constants_t::nodes_max];
+
+	/* Highest instance index seen + 1. */
+	std::size_t active_nodes;
+	std::uint64_t rejected_frames;
+};
+
+/**
+ * @brief Clear the table.
+ * @param table Table to clear.
+ */
+static inline void cn_node_table_init(cn_node_table_t &table)
+{
+	/* In place: a value-initialised temporary would be ~1.5 MB of stack. */
+	std::memset(&table, 0, sizeof(table));
+}
+
+/**
+ * @brief Store a decoded telemetry packet.
+ * @param table Table to update.
+ * @param instance Link instance of the sender.
+ * @param pkt Decoded packet.
+ */
+static inline void cn_node_table_store_telemetry(
+    cn_node_table_t &table,
+    std::uint16_t instance,
+    const telemetry_packet_t &pkt)
+{
+	table.node_id[instance] = pkt.node_id;
+	table.flags[instance] = pkt.flags;
+	table.primary_value[instance] = pkt.primary_value;
+	table.secondary_value[instance] = pkt.secondary_value;
+	table.potentiometer_raw[instance] = pkt.potentiometer_raw;
+	table.duty_commanded[instance] = pkt.duty_commanded;
+	++table.telemetry_count[instance];
+
+	if (instance >= table.active_nodes)
+	{
+		table.active_nodes = static_cast<std::size_t>(instance) + 1u;
+	}
+}
+
+/**
+ * @brief Store a decoded event packet.
+ * @param table Table to update.
+ * @param instance Link instance of the sender.
+ * @param pkt Decoded packet.
+ */
+static inline void cn_node_table_store_event(
+    cn_node_table_t &table,
+    std::uint16_t instance,
+    const event_packet_t &pkt)
+{
+	table.node_id[instance] = pkt.node_id;
+	table.last_event_type[instance] = pkt.event_type;
+	table.last_event_value[instance] = pkt.event_value;
+	table.last_event_timestamp[instance] = pkt.timestamp_ms_mod;
+	++table.event_count[instance];
+
+	if (instance >= table.active_nodes)
+	{
+		table.active_nodes = static_cast<std::size_t>(instance) + 1u;
+	}
+}
+
+/**
+ * @brief Count nodes currently reporting an active help request.
+ * @param table Table to scan.
+ * @return Number of nodes with help_active set.
+ */
+static inline std::size_t cn_node_table_help_count(const cn_node_table_t &table)
+{
+	std::size_t count = 0u;
+
+	for (std::size_t i = 0u; i < table.active_nodes; ++i)
+	{
+		count += ble_telemetry_flag_is_set(
+			     table.flags[i], ble_telemetry_flag_t::help_active)
+			     ? 1u
+			     : 0u;
+	}
+
+	return count;
+}
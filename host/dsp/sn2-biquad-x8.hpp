@@ -0,0 +1,203 @@
+/**
+ * @file	sn2-biquad-x8.hpp
+ * @brief	Eight-channel SIMD biquad cascade for host-side benchmarking
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * A biquad is recursive in time, so it does not vectorise along one
+ * channel. This header runs the firmware's Q15 sections
+ * (src/sn2-filter.hpp) over eight independent channels at once, one
+ * channel per 16-bit lane, on interleaved frames (sample n of channel c
+ * at in[8 n + c]). That is the shape of reprocessing many nodes' sound
+ * captures on the gateway, and gives a SIMD figure to compare the
+ * firmware's scalar per-sample cost against.
+ *
+ * The SSE2 path pairs each sample with its coefficient and uses
+ * _mm_madd_epi16, accumulating in 32 bits. It is bit-exact with the
+ * 64-bit scalar path whenever the unrounded accumulator fits in 32 bits,
+ * i.e. whenever a section's unsaturated output stays below four times
+ * full scale, which holds for the low/high/band-pass designs of
+ * sn2_biquad_design_q15(). The path is selected at compile time; other
+ * targets use the portable scalar path.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../../src/sn2-filter.hpp"
+
+/**
+ * @brief Direct form I state of one section for eight channels.
+ */
+struct sn2_biquad_x8_state_t final
+{
+	std::int16_t x1[8];
+	std::int16_t x2[8];
+	std::int16_t y1[8];
+	std::int16_t y2[8];
+};
+
+/**
+ * @brief Eight-channel cascade; every channel shares the coefficients.
+ */
+template <std::size_t Sections>
+struct sn2_biquad_cascade_x8_t final
+{
+	sn2_biquad_q15_t coeffs[Sections];
+	sn2_biquad_x8_state_t state[Sections];
+};
+
+/**
+ * @brief Load coefficients and clear the state of an eight-channel cascade.
+ */
+template <std::size_t Sections>
+static inline void sn2_biquad_cascade_x8_init(sn2_biquad_cascade_x8_t<Sections> &cascade,
+					      const sn2_biquad_q15_t (&coeffs)[Sections])
+{
+	for (std::size_t i = 0u; i < Sections; ++i)
+	{
+		cascade.coeffs[i] = coeffs[i];
+		cascade.state[i] = sn2_biquad_x8_state_t{};
+	}
+}
+
+/**
+ * @brief Portable eight-channel section over interleaved frames.
+ */
+static inline void sn2_biquad_x8_block_scalar(const sn2_biquad_q15_t &c,
+					      sn2_biquad_x8_state_t &state,
+					      const std::int16_t *in,
+					      std::int16_t *out,
+					      std::size_t frames)
+{
+	for (std::size_t ch = 0u; ch < 8u; ++ch)
+	{
+		sn2_biquad_state_q15_t s{state.x1[ch], state.x2[ch], state.y1[ch],
+					 state.y2[ch]};
+
+		for (std::size_t n = 0u; n < frames; ++n)
+		{
+			out[(n * 8u) + ch] = sn2_biquad_q15_step(c, s, in[(n * 8u) + ch]);
+		}
+		state.x1[ch] = s.x1;
+		state.x2[ch] = s.x2;
+		state.y1[ch] = s.y1;
+		state.y2[ch] = s.y2;
+	}
+}
+
+#if defined(__SSE2__)
+
+/**
+ * @brief Two coefficients repeated as (lo, hi) pairs for _mm_madd_epi16.
+ */
+static inline __m128i sn2_biquad_x8_pair(std::int16_t lo, std::int16_t hi)
+{
+	const std::uint32_t pair = static_cast<std::uint16_t>(lo) |
+				   (static_cast<std::uint32_t>(static_cast<std::uint16_t>(hi)) << 16);
+
+	return _mm_set1_epi32(static_cast<int>(pair));
+}
+
+/**
+ * @brief Sum of three pairwise products for four channels, rounded to Q15.
+ */
+static inline __m128i sn2_biquad_x8_acc(__m128i p0, __m128i k0,
+					__m128i p1, __m128i k1,
+					__m128i p2, __m128i k2)
+{
+	const __m128i round = _mm_set1_epi32(1 << (sn2_filter_constants_t::coeff_shift - 1));
+	__m128i acc = _mm_madd_epi16(p0, k0);
+
+	acc = _mm_add_epi32(acc, _mm_madd_epi16(p1, k1));
+	acc = _mm_add_epi32(acc, _mm_madd_epi16(p2, k2));
+
+	return _mm_srai_epi32(_mm_add_epi32(acc, round), sn2_filter_constants_t::coeff_shift);
+}
+
+/**
+ * @brief SSE2 eight-channel section over interleaved frames.
+ */
+static inline void sn2_biquad_x8_block_sse2(const sn2_biquad_q15_t &c,
+					    sn2_biquad_x8_state_t &state,
+					    const std::int16_t *in,
+					    std::int16_t *out,
+					    std::size_t frames)
+{
+	/* Pairs: (x0, x1)(b0, b1) + (x2, y1)(b2, -a1) + (y2, 0)(-a2, 0). */
+	const __m128i k0 = sn2_biquad_x8_pair(c.b0, c.b1);
+	const __m128i k1 = sn2_biquad_x8_pair(c.b2, static_cast<std::int16_t>(-c.a1));
+	const __m128i k2 = sn2_biquad_x8_pair(static_cast<std::int16_t>(-c.a2), 0);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state.x1));
+	__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state.x2));
+	__m128i y1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state.y1));
+	__m128i y2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state.y2));
+
+	for (std::size_t n = 0u; n < frames; ++n)
+	{
+		const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + (n * 8u)));
+		const __m128i lo = sn2_biquad_x8_acc(
+		    _mm_unpacklo_epi16(x0, x1), k0, _mm_unpacklo_epi16(x2, y1), k1,
+		    _mm_unpacklo_epi16(y2, zero), k2);
+		const __m128i hi = sn2_biquad_x8_acc(
+		    _mm_unpackhi_epi16(x0, x1), k0, _mm_unpackhi_epi16(x2, y1), k1,
+		    _mm_unpackhi_epi16(y2, zero), k2);
+		const __m128i y0 = _mm_packs_epi32(lo, hi);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out + (n * 8u)), y0);
+		x2 = x1;
+		x1 = x0;
+		y2 = y1;
+		y1 = y0;
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(state.x1), x1);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(state.x2), x2);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(state.y1), y1);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(state.y2), y2);
+}
+
+#endif /* __SSE2__ */
+
+/**
+ * @brief Filter interleaved eight-channel frames through a cascade.
+ * @param cascade Cascade.
+ * @param in Interleaved input, 8 * frames samples.
+ * @param out Interleaved output (may equal in).
+ * @param frames Number of frames.
+ * @param simd false forces the scalar path (for benchmarking).
+ */
+template <std::size_t Sections>
+static inline void sn2_biquad_cascade_x8_process(sn2_biquad_cascade_x8_t<Sections> &cascade,
+						 const std::int16_t *in,
+						 std::int16_t *out,
+						 std::size_t frames,
+						 bool simd = true)
+{
+	for (std::size_t i = 0u; i < Sections; ++i)
+	{
+		const std::int16_t *src = (i == 0u) ? in : out;
+
+#if defined(__SSE2__)
+		if (simd)
+		{
+			sn2_biquad_x8_block_sse2(cascade.coeffs[i], cascade.state[i], src, out,
+						 frames);
+			continue;
+		}
+#else
+		(void)simd;
+#endif
+		sn2_biquad_x8_block_scalar(cascade.coeffs[i], cascade.state[i], src, out,
+					   frames);
+	}
+}
@@ -0,0 +1,583 @@
+/**
+ * @file	sn2-replay.cpp
+ * @brief	Deterministic replay of SN2 traces through the application logic
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Commands:
+ *
+ * - run: feed the input and control records of a trace (sn2-trace.hpp)
+ *   into a fresh sn2_app_t on a virtual clock and compare every output
+ *   the application produces, bit-for-bit and in order, with the
+ *   outputs stored in the trace. There is no sleeping: the clock is the
+ *   now_ms carried by each input record, so replay runs as fast as the
+ *   application code allows.
+ * - synth: generate a synthetic trace (temperature drift, microphone
+ *   blocks with tone bursts, potentiometer moves, bouncing help presses
+ *   and override writes) and record the current application's outputs
+ *   alongside it. The result is a golden trace for regression runs.
+ *
+ * Usage:
+ *	sn2-replay run TRACE [--instance N] [--report N]
+ *	sn2-replay synth TRACE [--hours H] [--step-ms MS] [--seed N]
+ *
+ * run exits with status 1 if any output diverged.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../capture/sn2-capture.hpp"
+#include "../../src/sn2-oversample.hpp"
+#include "../shim/sn2-sound-synth.hpp"
+#include "sn2-trace.hpp"
+
+namespace
+{
+
+/**
+ * @brief One output waiting to be matched against the trace.
+ */
+struct replay_output_t final
+{
+	sn2_trace_kind_t kind;
+	std::uint8_t bytes[sn2_trace_constants_t::record_max];
+	std::size_t size;
+};
+
+/**
+ * @brief Replay state and statistics.
+ */
+struct replay_t final
+{
+	static constexpr std::size_t pending_max = 16u;
+
+	replay_output_t pending[pending_max];
+	std::size_t pending_head;
+	std::size_t pending_count;
+	bool overflow;
+
+	std::uint64_t steps;
+	std::uint64_t sound_blocks;
+	std::uint64_t controls;
+	std::uint64_t outputs_matched;
+	std::uint64_t divergences;
+	std::uint64_t report_max;
+	std::uint64_t last_timestamp_us;
+};
+
+/**
+ * @brief Synthetic input generator state.
+ */
+struct synth_t final
+{
+	std::uint32_t rng;
+	double temp_c;
+	double temp_walk_c;
+	sound_synth_t sound;
+	std::uint64_t sound_samples;
+	std::uint16_t pot_raw;
+	std::uint32_t button_until_ms;
+	std::uint32_t bounce_until_ms;
+};
+
+const char *replay_option(int argc, char **argv, const char *name,
+			  const char *fallback)
+{
+	const char *value = fallback;
+
+	for (int i = 3; (i + 1) < argc; ++i)
+	{
+		if (std::strcmp(argv[i], name) == 0)
+		{
+			value = argv[i + 1];
+		}
+	}
+
+	return value;
+}
+
+const char *replay_kind_name(sn2_trace_kind_t kind)
+{
+	const char *name = "unknown";
+
+	switch (kind)
+	{
+	case sn2_trace_kind_t::telemetry:
+		name = "telemetry";
+		break;
+	case sn2_trace_kind_t::event:
+		name = "event";
+		break;
+	case sn2_trace_kind_t::control:
+		name = "control";
+		break;
+	case sn2_trace_kind_t::input:
+		name = "input";
+		break;
+	case sn2_trace_kind_t::fan_duty:
+		name = "fan_duty";
+		break;
+	case sn2_trace_kind_t::leds:
+		name = "leds";
+		break;
+	case sn2_trace_kind_t::sound:
+		name = "sound";
+		break;
+	}
+
+	return name;
+}
+
+void replay_print_bytes(const std::uint8_t *bytes, std::size_t size)
+{
+	for (std::size_t i = 0u; i < size; ++i)
+	{
+		std::fprintf(stderr, " %02x", bytes[i]);
+	}
+}
+
+void replay_diverged(replay_t &replay, const char *what,
+		     const replay_output_t *produced,
+		     const capture_frame_t *recorded)
+{
+	if (replay.divergences < replay.report_max)
+	{
+		std::fprintf(stderr, "divergence at %.3f s (step %llu): %s\n",
+			     static_cast<double>(replay.last_timestamp_us) / 1.0e6,
+			     static_cast<unsigned long long>(replay.steps), what);
+		if (recorded != nullptr)
+		{
+			std::fprintf(stderr, "  recorded %-9s",
+				     replay_kind_name(
+					 static_cast<sn2_trace_kind_t>(recorded->kind)));
+			replay_print_bytes(recorded->payload, recorded->length);
+			std::fprintf(stderr, "\n");
+		}
+		if (produced != nullptr)
+		{
+			std::fprintf(stderr, "  produced %-9s",
+				     replay_kind_name(produced->kind));
+			replay_print_bytes(produced->bytes, produced->size);
+			std::fprintf(stderr, "\n");
+		}
+	}
+	++replay.divergences;
+}
+
+void replay_emit(void *context, sn2_trace_kind_t kind, const std::uint8_t *data,
+		 std::size_t size)
+{
+	replay_t &replay = *static_cast<replay_t *>(context);
+
+	if ((replay.pending_count == replay_t::pending_max) ||
+	    (size > sn2_trace_constants_t::record_max))
+	{
+		replay.overflow = true;
+	}
+	else
+	{
+		replay_output_t &out =
+		    replay.pending[(replay.pending_head + replay.pending_count) %
+				   replay_t::pending_max];
+
+		out.kind = kind;
+		out.size = size;
+		std::memcpy(out.bytes, data, size);
+		++replay.pending_count;
+	}
+}
+
+/* Everything the previous step produced must have been in the trace. */
+void replay_flush_unmatched(replay_t &replay)
+{
+	while (replay.pending_count != 0u)
+	{
+		replay_diverged(replay, "output missing from recording",
+				&replay.pending[replay.pending_head], nullptr);
+		replay.pending_head = (replay.pending_head + 1u) % replay_t::pending_max;
+		--replay.pending_count;
+	}
+
+	if (replay.overflow)
+	{
+		replay_diverged(replay, "too many outputs in one step", nullptr,
+				nullptr);
+		replay.overflow = false;
+	}
+}
+
+void replay_match(replay_t &replay, const capture_frame_t &frame)
+{
+	if (replay.pending_count == 0u)
+	{
+		replay_diverged(replay, "recorded output not produced", nullptr,
+				&frame);
+	}
+	else
+	{
+		const replay_output_t &out = replay.pending[replay.pending_head];
+
+		if ((static_cast<std::uint8_t>(out.kind) == frame.kind) &&
+		    (out.size == frame.length) &&
+		    (std::memcmp(out.bytes, frame.payload, out.size) == 0))
+		{
+			++replay.outputs_matched;
+		}
+		else
+		{
+			replay_diverged(replay, "output differs", &out, &frame);
+		}
+		replay.pending_head = (replay.pending_head + 1u) % replay_t::pending_max;
+		--replay.pending_count;
+	}
+}
+
+int replay_run(const char *path, std::uint16_t instance, std::uint64_t report_max)
+{
+	capture_reader_t reader{};
+	capture_frame_t frame{};
+	sn2_app_t app{};
+	sn2_trace_tap_t tap{};
+	static replay_t replay{};
+
+	if (!capture_reader_open(reader, path))
+	{
+		std::fprintf(stderr, "sn2-replay: %s is not a capture\n", path);
+		return 1;
+	}
+
+	replay.report_max = report_max;
+	sn2_app_init(app, sn2_default_config());
+	const sn2_io_t io = sn2_trace_tap_init(tap, &replay, replay_emit);
+	const auto start = std::chrono::steady_clock::now();
+
+	while (capture_reader_next(reader, frame))
+	{
+		const sn2_trace_kind_t kind = static_cast<sn2_trace_kind_t>(frame.kind);
+
+		if (frame.instance != instance)
+		{
+			continue;
+		}
+
+		replay.last_timestamp_us = frame.timestamp_us;
+		if (kind == sn2_trace_kind_t::input)
+		{
+			sn2_inputs_t in{};
+
+			replay_flush_unmatched(replay);
+			if (sn2_trace_decode_input(in, frame.payload, frame.length))
+			{
+				sn2_app_step(app, in, io);
+				++replay.steps;
+			}
+			else
+			{
+				replay_diverged(replay, "malformed input record", nullptr,
+						&frame);
+			}
+		}
+		else if (kind == sn2_trace_kind_t::sound)
+		{
+			std::uint16_t samples[sn2_sound_constants_t::block_samples];
+			std::uint32_t timestamp_ms = 0u;
+
+			replay_flush_unmatched(replay);
+			if (sn2_trace_decode_sound(samples, timestamp_ms, frame.payload,
+						   frame.length))
+			{
+				sn2_app_sound(app, samples, sn2_sound_constants_t::block_samples,
+					      timestamp_ms, io);
+				++replay.sound_blocks;
+			}
+			else
+			{
+				replay_diverged(replay, "malformed sound record", nullptr,
+						&frame);
+			}
+		}
+		else if (kind == sn2_trace_kind_t::control)
+		{
+			replay_flush_unmatched(replay);
+			(void)sn2_app_control(app, frame.payload, frame.length);
+			++replay.controls;
+		}
+		else
+		{
+			replay_match(replay, frame);
+		}
+	}
+	replay_flush_unmatched(replay);
+
+	const double secs = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start)
+				.count();
+	const double virtual_s =
+	    static_cast<double>(replay.last_timestamp_us) / 1.0e6;
+
+	std::printf("%llu steps, %llu sound blocks, %llu controls, "
+		    "%llu outputs matched, %llu divergences\n",
+		    static_cast<unsigned long long>(replay.steps),
+		    static_cast<unsigned long long>(replay.sound_blocks),
+		    static_cast<unsigned long long>(replay.controls),
+		    static_cast<unsigned long long>(replay.outputs_matched),
+		    static_cast<unsigned long long>(replay.divergences));
+	std::printf("%.1f s of node time in %.3f s (%.0fx, %.1f ns/step)\n",
+		    virtual_s, secs, (secs > 0.0) ? (virtual_s / secs) : 0.0,
+		    (replay.steps != 0u)
+			? ((secs * 1.0e9) / static_cast<double>(replay.steps))
+			: 0.0);
+	capture_reader_close(reader);
+
+	return (replay.divergences == 0u) ? 0 : 1;
+}
+
+/**
+ * @brief xorshift32 step.
+ */
+std::uint32_t synth_rand(std::uint32_t &state)
+{
+	std::uint32_t x = state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	state = x;
+
+	return x;
+}
+
+double synth_uniform(std::uint32_t &state)
+{
+	return static_cast<double>(synth_rand(state)) / 4294967296.0;
+}
+
+bool synth_chance(std::uint32_t &state, std::uint32_t step_ms, double mean_ms)
+{
+	return synth_uniform(state) < (static_cast<double>(step_ms) / mean_ms);
+}
+
+/**
+ * @brief Noise-free ADC level the thermistor divider produces at temp_c.
+ */
+double synth_thermistor_adc(const sn2_thermistor_params_t &params, double temp_c)
+{
+	const double t0 = params.t0_c + sn2_thermistor_constants_t::kelvin_offset;
+	const double r = params.r0_ohm *
+			 std::exp(params.beta *
+				  ((1.0 / (temp_c + sn2_thermistor_constants_t::kelvin_offset)) -
+				   (1.0 / t0)));
+
+	return static_cast<double>(params.adc_max) * r / (r + params.divider_r_ohm);
+}
+
+/**
+ * @brief Oversampled burst of conversions with about one LSB of noise.
+ */
+std::uint16_t synth_thermistor_burst(synth_t &synth, const sn2_config_t &config,
+				     double level)
+{
+	return sn2_oversample_burst(
+	    [&synth, &config, level] {
+		    const long code = std::lround(level + (synth_uniform(synth.rng) - 0.5) +
+						  (synth_uniform(synth.rng) - 0.5));
+
+		    return (code < 0) ? 0L : ((code > config.adc_max) ? config.adc_max : code);
+	    },
+	    config.temperature_oversample_bits);
+}
+
+sn2_inputs_t synth_step(synth_t &synth, const sn2_config_t &config,
+			std::uint32_t now_ms, std::uint32_t step_ms, bool temperature_due)
+{
+	sn2_inputs_t in{};
+	const double day = std::sin((2.0 * 3.14159265358979323846 *
+				     static_cast<double>(now_ms)) /
+				    86400000.0);
+
+	synth.temp_walk_c += (synth_uniform(synth.rng) - 0.5) * 0.02;
+	synth.temp_walk_c *= 0.9999;
+
+	if (synth_chance(synth.rng, step_ms, 60000.0))
+	{
+		synth.pot_raw = static_cast<std::uint16_t>(synth_rand(synth.rng) %
+							   (config.adc_max + 1u));
+	}
+	if (synth_chance(synth.rng, step_ms, 600000.0))
+	{
+		synth.button_until_ms = now_ms + 150u + (synth_rand(synth.rng) % 400u);
+		synth.bounce_until_ms = now_ms + 15u;
+	}
+
+	in.now_ms = now_ms;
+	if (temperature_due)
+	{
+		in.temperature_raw = synth_thermistor_burst(
+		    synth, config,
+		    synth_thermistor_adc(sn2_thermistor_default_params(),
+					 synth.temp_c + (day * 1.5) + synth.temp_walk_c));
+		in.temperature_fresh = true;
+	}
+	in.potentiometer_raw = synth.pot_raw;
+	in.help_button = static_cast<std::int32_t>(synth.button_until_ms - now_ms) > 0;
+	if (static_cast<std::int32_t>(synth.bounce_until_ms - now_ms) > 0)
+	{
+		in.help_button = (synth_rand(synth.rng) & 1u) != 0u;
+	}
+
+	return in;
+}
+
+struct synth_sink_t final
+{
+	capture_writer_t *writer;
+	std::uint64_t timestamp_us;
+	bool ok;
+};
+
+void synth_emit(void *context, sn2_trace_kind_t kind, const std::uint8_t *data,
+		std::size_t size)
+{
+	synth_sink_t &sink = *static_cast<synth_sink_t *>(context);
+
+	sink.ok = capture_writer_append(*sink.writer, sink.timestamp_us, 0u,
+					static_cast<std::uint8_t>(kind), data,
+					size) &&
+		  sink.ok;
+}
+
+int replay_synth(const char *path, double hours, std::uint32_t step_ms,
+		 std::uint32_t seed)
+{
+	capture_writer_t writer{};
+	synth_sink_t sink{&writer, 0u, true};
+	sn2_app_t app{};
+	sn2_trace_tap_t tap{};
+	synth_t synth{};
+	const sn2_config_t config = sn2_default_config();
+	const std::uint64_t steps = static_cast<std::uint64_t>(
+	    (hours * 3600000.0) / static_cast<double>(step_ms));
+
+	(void)unlink(path);
+	if ((step_ms == 0u) || !capture_writer_open(writer, path, 0u))
+	{
+		std::fprintf(stderr, "sn2-replay: cannot create %s\n", path);
+		return 1;
+	}
+
+	synth.rng = seed | 1u;
+	sound_synth_init(synth.sound, seed * 2654435761u);
+	synth.temp_c = 20.0 + (synth_uniform(synth.rng) * 6.0);
+	synth.pot_raw = static_cast<std::uint16_t>(synth_rand(synth.rng) %
+						   (config.adc_max + 1u));
+	sn2_app_init(app, config);
+	const sn2_io_t io = sn2_trace_tap_init(tap, &sink, synth_emit);
+
+	for (std::uint64_t i = 0u; (i < steps) && sink.ok; ++i)
+	{
+		const std::uint32_t now_ms = static_cast<std::uint32_t>(i * step_ms);
+		std::uint8_t bytes[sn2_trace_constants_t::input_size];
+
+		sink.timestamp_us = i * step_ms * 1000u;
+
+		if (synth_chance(synth.rng, step_ms, 900000.0))
+		{
+			const bool enable = (synth_rand(synth.rng) & 1u) != 0u;
+			const control_packet_t pkt = ble_make_control(
+			    ble_node_id_t::sn2,
+			    enable ? static_cast<std::uint16_t>(
+					 ble_control_flag_t::override_enable)
+				   : static_cast<std::uint16_t>(
+					 ble_control_flag_t::clear_help_request),
+			    static_cast<std::uint16_t>(synth_rand(synth.rng) % 1001u));
+			std::uint8_t ctrl[sizeof(control_packet_t)];
+
+			if (ble_pack_control(ctrl, sizeof(ctrl), pkt))
+			{
+				synth_emit(&sink, sn2_trace_kind_t::control, ctrl,
+					   sizeof(ctrl));
+				(void)sn2_app_control(app, ctrl, sizeof(ctrl));
+			}
+		}
+
+		/* Microphone blocks that completed since the previous step. */
+		while (((synth.sound_samples + sn2_sound_constants_t::block_samples) *
+			1000u) <=
+		       (static_cast<std::uint64_t>(i * step_ms) *
+			sn2_sound_constants_t::sample_rate_hz))
+		{
+			std::uint16_t samples[sn2_sound_constants_t::block_samples];
+			std::uint8_t record[sn2_trace_constants_t::sound_size];
+
+			synth.sound_samples += sn2_sound_constants_t::block_samples;
+			const std::uint32_t block_ms = static_cast<std::uint32_t>(
+			    (synth.sound_samples * 1000u) /
+			    sn2_sound_constants_t::sample_rate_hz);
+
+			for (std::uint16_t &sample : samples)
+			{
+				sample = sound_synth_sample(synth.sound);
+			}
+			sn2_trace_encode_sound(record, samples, block_ms);
+			synth_emit(&sink, sn2_trace_kind_t::sound, record, sizeof(record));
+			sn2_app_sound(app, samples, sn2_sound_constants_t::block_samples,
+				      block_ms, io);
+		}
+
+		const sn2_inputs_t in = synth_step(synth, config, now_ms, step_ms,
+						   sn2_app_temperature_due(app, now_ms));
+
+		sn2_trace_encode_input(bytes, in);
+		synth_emit(&sink, sn2_trace_kind_t::input, bytes, sizeof(bytes));
+		sn2_app_step(app, in, io);
+	}
+
+	std::fprintf(stderr, "sn2-replay: %llu records written\n",
+		     static_cast<unsigned long long>(writer.records));
+	capture_writer_close(writer);
+
+	return sink.ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	int rc = 2;
+
+	if ((argc >= 3) && (std::strcmp(argv[1], "run") == 0))
+	{
+		rc = replay_run(
+		    argv[2],
+		    static_cast<std::uint16_t>(std::strtoul(
+			replay_option(argc, argv, "--instance", "0"), nullptr, 0)),
+		    std::strtoull(replay_option(argc, argv, "--report", "10"),
+				  nullptr, 0));
+	}
+	else if ((argc >= 3) && (std::strcmp(argv[1], "synth") == 0))
+	{
+		rc = replay_synth(
+		    argv[2],
+		    std::strtod(replay_option(argc, argv, "--hours", "24"), nullptr),
+		    static_cast<std::uint32_t>(std::strtoul(
+			replay_option(argc, argv, "--step-ms", "10"), nullptr, 0)),
+		    static_cast<std::uint32_t>(std::strtoul(
+			replay_option(argc, argv, "--seed", "1"), nullptr, 0)));
+	}
+	else
+	{
+		std::fprintf(stderr,
+			     "usage: %s run TRACE [--instance N] [--report N]\n"
+			     "       %s synth TRACE [--hours H] [--step-ms MS] "
+			     "[--seed N]\n",
+			     argv[0], argv[0]);
+	}
+
+	return rc;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file	sn2-trace-recorder.hpp
+ * @brief	Records a replay trace from the firmware glue in native builds
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * src/Sensor-Node-2.cpp built against host/shim calls these hooks at the
+ * points where loop() feeds the application: each control packet taken
+ * from the mailbox, each microphone block and each scan. The outputs
+ * go through a trace tap (sn2-trace.hpp) teed in front of the glue's
+ * own sn2_io_t, so the file holds inputs and outputs in the order they
+ * happened and `sn2-replay run` can check it bit-for-bit.
+ *
+ * The trace starts empty and assumes the application was initialised
+ * with sn2_default_config(); a calibration loaded from EEPROM or set with
+ * the calibrate cloud function is not recorded. Every hook is a no-op
+ * while no file is open. Each record is one write() (sn2-capture.hpp),
+ * so the trace is complete whenever the process stops.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../capture/sn2-capture.hpp"
+#include "sn2-trace.hpp"
+
+/**
+ * @brief Trace recorder state.
+ */
+struct sn2_trace_recorder_t final
+{
+	capture_writer_t writer;
+	sn2_trace_tap_t tap;
+	sn2_io_t tap_io;
+	sn2_io_t inner;
+	std::uint64_t timestamp_us; /* stamp of the input being recorded */
+	bool open;
+};
+
+namespace sn2_trace_recorder_detail
+{
+
+inline void emit(void *context, sn2_trace_kind_t kind, const std::uint8_t *data,
+		 std::size_t size)
+{
+	sn2_trace_recorder_t &rec = *static_cast<sn2_trace_recorder_t *>(context);
+
+	(void)capture_writer_append(rec.writer, rec.timestamp_us, 0u,
+				    static_cast<std::uint8_t>(kind), data, size);
+}
+
+inline void notify(void *context, sn2_channel_t channel, const std::uint8_t *data,
+		   std::size_t size)
+{
+	sn2_trace_recorder_t &rec = *static_cast<sn2_trace_recorder_t *>(context);
+
+	rec.tap_io.notify(rec.tap_io.context, channel, data, size);
+	rec.inner.notify(rec.inner.context, channel, data, size);
+}
+
+inline void set_fan_duty(void *context, std::uint16_t duty_per_mille)
+{
+	sn2_trace_recorder_t &rec = *static_cast<sn2_trace_recorder_t *>(context);
+
+	rec.tap_io.set_fan_duty(rec.tap_io.context, duty_per_mille);
+	rec.inner.set_fan_duty(rec.inner.context, duty_per_mille);
+}
+
+inline void set_leds(void *context, bool help_led, bool override_led)
+{
+	sn2_trace_recorder_t &rec = *static_cast<sn2_trace_recorder_t *>(context);
+
+	rec.tap_io.set_leds(rec.tap_io.context, help_led, override_led);
+	rec.inner.set_leds(rec.inner.context, help_led, override_led);
+}
+
+} // namespace sn2_trace_recorder_detail
+
+/**
+ * @brief Start a new trace, replacing any file at path.
+ * @param rec Recorder to initialise (must outlive the returned io).
+ * @param path Trace file.
+ * @param inner The glue's own output callbacks.
+ * @param io Callbacks to give the application: record, then call inner.
+ * @return true if the file was created, otherwise false (io = inner).
+ */
+static inline bool sn2_trace_recorder_open(sn2_trace_recorder_t &rec,
+					   const char *path,
+					   const sn2_io_t &inner,
+					   sn2_io_t &io)
+{
+	rec = sn2_trace_recorder_t{};
+	rec.writer.fd = -1;
+	rec.inner = inner;
+	rec.tap_io = sn2_trace_tap_init(rec.tap, &rec, sn2_trace_recorder_detail::emit);
+	(void)unlink(path);
+	rec.open = capture_writer_open(rec.writer, path, 0u);
+	io = rec.open ? sn2_io_t{&rec, sn2_trace_recorder_detail::notify,
+				 sn2_trace_recorder_detail::set_fan_duty,
+				 sn2_trace_recorder_detail::set_leds}
+		      : inner;
+
+	return rec.open;
+}
+
+/**
+ * @brief Record a control packet about to be applied.
+ * @param rec Recorder.
+ * @param now_ms Time it is applied.
+ * @param pkt Packet taken from the mailbox.
+ */
+static inline void sn2_trace_recorder_control(sn2_trace_recorder_t &rec,
+					      std::uint32_t now_ms,
+					      const control_packet_t &pkt)
+{
+	std::uint8_t bytes[sizeof(control_packet_t)];
+
+	if (rec.open && ble_pack_control(bytes, sizeof(bytes), pkt))
+	{
+		rec.timestamp_us = static_cast<std::uint64_t>(now_ms) * 1000u;
+		sn2_trace_recorder_detail::emit(&rec, sn2_trace_kind_t::control, bytes,
+						sizeof(bytes));
+	}
+}
+
+/**
+ * @brief Record a microphone block about to go to sn2_app_sound().
+ * @param rec Recorder.
+ * @param samples Block samples (sn2_sound_constants_t::block_samples).
+ * @param timestamp_ms Block timestamp.
+ */
+static inline void sn2_trace_recorder_sound(sn2_trace_recorder_t &rec,
+					    const std::uint16_t *samples,
+					    std::uint32_t timestamp_ms)
+{
+	std::uint8_t bytes[sn2_trace_constants_t::sound_size];
+
+	if (rec.open)
+	{
+		rec.timestamp_us = static_cast<std::uint64_t>(timestamp_ms) * 1000u;
+		sn2_trace_encode_sound(bytes, samples, timestamp_ms);
+		sn2_trace_recorder_detail::emit(&rec, sn2_trace_kind_t::sound, bytes,
+						sizeof(bytes));
+	}
+}
+
+/**
+ * @brief Record a scan about to go to sn2_app_step().
+ */
+static inline void sn2_trace_recorder_input(sn2_trace_recorder_t &rec, const sn2_inputs_t &in)
+{
+	std::uint8_t bytes[sn2_trace_constants_t::input_size];
+
+	if (rec.open)
+	{
+		rec.timestamp_us = static_cast<std::uint64_t>(in.now_ms) * 1000u;
+		sn2_trace_encode_input(bytes, in);
+		sn2_trace_recorder_detail::emit(&rec, sn2_trace_kind_t::input, bytes,
+						sizeof(bytes));
+	}
+}
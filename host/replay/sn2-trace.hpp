@@ -0,0 +1,231 @@
+/**
+ * @file	sn2-trace.hpp
+ * @brief	Input/output trace records for deterministic SN2 replay
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * A trace is a capture log (sn2-capture.hpp) of one node's life: every
+ * hardware sample fed to sn2_app_step(), every control write and every
+ * output the application produced, in the order they happened. Inputs
+ * and local outputs use the capture kinds reserved for non-BLE records:
+ *
+ * - input (0x80): one application step. Payload is now_ms (u32),
+ *   temperature_raw, potentiometer_raw (u16 each) and a flag bitmap
+ *   (u8, bit 0 = help button, bit 1 = temperature_fresh), little-endian,
+ *   9 bytes.
+ * - fan_duty (0x81): duty_commanded changed, u16 per-mille.
+ * - leds (0x82): LED outputs changed, u8 (bit 0 = help, bit 1 = override).
+ * - sound (0x83): one microphone block given to sn2_app_sound(). Payload
+ *   is the block timestamp (u32) followed by the u16 samples.
+ *
+ * Control writes use kind control (3) and are applied in trace order,
+ * like sound blocks. Notifications use kinds telemetry (1) and event (2) and
+ * follow the input record of the step that produced them.
+ *
+ * sn2_trace_tap_t turns the application's sn2_io_t callbacks into trace
+ * records, suppressing repeated fan/LED writes, so recording and
+ * replay observe outputs through exactly the same filter.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../../protocol/ble-protocol.hpp"
+#include "../../src/sn2-app.hpp"
+#include "../sim/sn2-sim-link.hpp"
+
+/**
+ * @brief Trace record kinds (capture record kind byte).
+ */
+enum class sn2_trace_kind_t : std::uint8_t
+{
+	telemetry = static_cast<std::uint8_t>(sim_characteristic_t::telemetry),
+	event = static_cast<std::uint8_t>(sim_characteristic_t::event),
+	control = static_cast<std::uint8_t>(sim_characteristic_t::control),
+	input = 0x80u,
+	fan_duty = 0x81u,
+	leds = 0x82u,
+	sound = 0x83u
+};
+
+/**
+ * @brief Trace payload sizes.
+ */
+struct sn2_trace_constants_t final
+{
+	static constexpr std::size_t input_size = 9u;
+	static constexpr std::size_t sound_size =
+	    4u + (2u * sn2_sound_constants_t::block_samples);
+	static constexpr std::size_t fan_duty_size = 2u;
+	static constexpr std::size_t leds_size = 1u;
+	static constexpr std::size_t record_max = sizeof(telemetry_packet_t);
+};
+
+/**
+ * @brief Encode one application step.
+ * @param dst Destination (input_size bytes).
+ * @param in Step inputs.
+ */
+static inline void sn2_trace_encode_input(std::uint8_t *dst, const sn2_inputs_t &in)
+{
+	ble_store_le<std::uint32_t>(dst, in.now_ms);
+	ble_store_le<std::uint16_t>(dst + 4u, in.temperature_raw);
+	ble_store_le<std::uint16_t>(dst + 6u, in.potentiometer_raw);
+	dst[8] = static_cast<std::uint8_t>((in.help_button ? 1u : 0u) |
+					   (in.temperature_fresh ? 2u : 0u));
+}
+
+/**
+ * @brief Decode one application step.
+ * @param in Decoded inputs.
+ * @param src Payload.
+ * @param size Payload size.
+ * @return true if the payload is a valid input record, otherwise false.
+ */
+static inline bool sn2_trace_decode_input(sn2_inputs_t &in,
+					  const std::uint8_t *src,
+					  std::size_t size)
+{
+	bool ok = (src != nullptr) && (size == sn2_trace_constants_t::input_size);
+
+	if (ok)
+	{
+		in.now_ms = ble_load_le<std::uint32_t>(src);
+		in.temperature_raw = ble_load_le<std::uint16_t>(src + 4u);
+		in.potentiometer_raw = ble_load_le<std::uint16_t>(src + 6u);
+		in.help_button = (src[8] & 1u) != 0u;
+		in.temperature_fresh = (src[8] & 2u) != 0u;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Encode one microphone block.
+ * @param dst Destination (sound_size bytes).
+ * @param samples Block samples (sn2_sound_constants_t::block_samples).
+ * @param timestamp_ms Block timestamp.
+ */
+static inline void sn2_trace_encode_sound(std::uint8_t *dst,
+					  const std::uint16_t *samples,
+					  std::uint32_t timestamp_ms)
+{
+	ble_store_le<std::uint32_t>(dst, timestamp_ms);
+	for (std::size_t i = 0u; i < sn2_sound_constants_t::block_samples; ++i)
+	{
+		ble_store_le<std::uint16_t>(dst + 4u + (2u * i), samples[i]);
+	}
+}
+
+/**
+ * @brief Decode one microphone block.
+ * @param samples Destination (sn2_sound_constants_t::block_samples).
+ * @param timestamp_ms Decoded block timestamp.
+ * @param src Payload.
+ * @param size Payload size.
+ * @return true if the payload is a valid sound record, otherwise false.
+ */
+static inline bool sn2_trace_decode_sound(std::uint16_t *samples,
+					  std::uint32_t &timestamp_ms,
+					  const std::uint8_t *src,
+					  std::size_t size)
+{
+	const bool ok = (src != nullptr) && (size == sn2_trace_constants_t::sound_size);
+
+	if (ok)
+	{
+		timestamp_ms = ble_load_le<std::uint32_t>(src);
+		for (std::size_t i = 0u; i < sn2_sound_constants_t::block_samples; ++i)
+		{
+			samples[i] = ble_load_le<std::uint16_t>(src + 4u + (2u * i));
+		}
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Adapter from sn2_io_t callbacks to trace records.
+ */
+struct sn2_trace_tap_t final
+{
+	void *context;
+	void (*emit)(void *context,
+		     sn2_trace_kind_t kind,
+		     const std::uint8_t *data,
+		     std::size_t size);
+
+	std::uint16_t fan_duty;
+	std::uint8_t leds;
+	bool fan_valid;
+	bool leds_valid;
+};
+
+namespace sn2_trace_detail
+{
+
+inline void notify(void *context, sn2_channel_t channel, const std::uint8_t *data,
+		   std::size_t size)
+{
+	sn2_trace_tap_t &tap = *static_cast<sn2_trace_tap_t *>(context);
+
+	tap.emit(tap.context,
+		 (channel == sn2_channel_t::telemetry) ? sn2_trace_kind_t::telemetry
+						       : sn2_trace_kind_t::event,
+		 data, size);
+}
+
+inline void set_fan_duty(void *context, std::uint16_t duty_per_mille)
+{
+	sn2_trace_tap_t &tap = *static_cast<sn2_trace_tap_t *>(context);
+
+	if (!tap.fan_valid || (tap.fan_duty != duty_per_mille))
+	{
+		std::uint8_t bytes[sn2_trace_constants_t::fan_duty_size];
+
+		tap.fan_duty = duty_per_mille;
+		tap.fan_valid = true;
+		ble_store_le<std::uint16_t>(bytes, duty_per_mille);
+		tap.emit(tap.context, sn2_trace_kind_t::fan_duty, bytes, sizeof(bytes));
+	}
+}
+
+inline void set_leds(void *context, bool help_led, bool override_led)
+{
+	sn2_trace_tap_t &tap = *static_cast<sn2_trace_tap_t *>(context);
+	const std::uint8_t leds = static_cast<std::uint8_t>(
+	    (help_led ? 1u : 0u) | (override_led ? 2u : 0u));
+
+	if (!tap.leds_valid || (tap.leds != leds))
+	{
+		tap.leds = leds;
+		tap.leds_valid = true;
+		tap.emit(tap.context, sn2_trace_kind_t::leds, &leds, sizeof(leds));
+	}
+}
+
+} // namespace sn2_trace_detail
+
+/**
+ * @brief Initialise a tap and return the sn2_io_t that feeds it.
+ * @param tap Tap to initialise (must outlive the returned io).
+ * @param context Context passed to emit.
+ * @param emit Record sink.
+ * @return Output callbacks for sn2_app_step().
+ */
+static inline sn2_io_t sn2_trace_tap_init(
+    sn2_trace_tap_t &tap,
+    void *context,
+    void (*emit)(void *, sn2_trace_kind_t, const std::uint8_t *, std::size_t))
+{
+	tap = sn2_trace_tap_t{};
+	tap.context = context;
+	tap.emit = emit;
+
+	return sn2_io_t{&tap, sn2_trace_detail::notify,
+			sn2_trace_detail::set_fan_duty, sn2_trace_detail::set_leds};
+}
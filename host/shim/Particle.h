@@ -0,0 +1,420 @@
+/**
+ * @file	Particle.h
+ * @brief	Host shim for the subset of the Particle Device OS API used by SN2
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Lets src/Sensor-Node-2.cpp build unmodified as a native Linux program
+ * (add host/shim to the include path). Only what the firmware uses is
+ * provided, with the same names and call shapes as Device OS:
+ *
+ * - SYSTEM_MODE(), SYSTEM_THREAD(), SerialLogHandler, Log
+ * - millis(), micros(), delay()
+ * - pinMode(), digitalRead(), digitalWrite(), analogRead(), analogWrite()
+ * - BleUuid, BleCharacteristic, BleAdvertisingData, BlePeerDevice, BLE
+ * - EEPROM (get/put over an erased 4 KB array), String, Particle.function()
+ *
+ * Pin state and BLE traffic are held in shim_hw(); particle-shim.cpp
+ * supplies main(), the clock and the test-side hooks declared at the
+ * end of this file.
+ */
+
+#pragma once
+
+/* Lets the firmware enable host-only hooks, e.g. trace recording. */
+#define SN2_HOST_SHIM 1
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <sys/types.h>
+
+#define SYSTEM_MODE(mode) static_assert(true, "")
+#define SYSTEM_THREAD(state) static_assert(true, "")
+
+typedef std::uint16_t pin_t;
+
+enum PinMode : std::uint8_t
+{
+	INPUT = 0u,
+	OUTPUT = 1u,
+	INPUT_PULLUP = 2u,
+	INPUT_PULLDOWN = 3u
+};
+
+constexpr std::uint8_t LOW = 0u;
+constexpr std::uint8_t HIGH = 1u;
+
+constexpr pin_t D0 = 0u;
+constexpr pin_t D1 = 1u;
+constexpr pin_t D2 = 2u;
+constexpr pin_t D3 = 3u;
+constexpr pin_t D4 = 4u;
+constexpr pin_t D5 = 5u;
+constexpr pin_t D6 = 6u;
+constexpr pin_t D7 = 7u;
+constexpr pin_t D8 = 8u;
+constexpr pin_t D9 = 9u;
+constexpr pin_t D10 = 10u;
+constexpr pin_t A0 = 11u;
+constexpr pin_t A1 = 12u;
+constexpr pin_t A2 = 13u;
+constexpr pin_t A3 = 14u;
+constexpr pin_t A4 = 15u;
+constexpr pin_t A5 = 16u;
+constexpr pin_t TOTAL_PINS = 17u;
+
+constexpr std::size_t shim_eeprom_size = 4096u;
+
+enum LogLevel : std::uint8_t
+{
+	LOG_LEVEL_ALL = 1u,
+	LOG_LEVEL_TRACE = 1u,
+	LOG_LEVEL_INFO = 30u,
+	LOG_LEVEL_WARN = 40u,
+	LOG_LEVEL_ERROR = 50u,
+	LOG_LEVEL_NONE = 70u
+};
+
+/**
+ * @brief Simulated hardware state shared by the shim and the test side.
+ */
+struct shim_hw_t final
+{
+	std::uint8_t pin_mode[TOTAL_PINS];
+	/* Inputs are read by the acquisition port's thread. */
+	std::atomic<std::uint8_t> digital_in[TOTAL_PINS];
+	std::uint8_t digital_out[TOTAL_PINS];
+	std::atomic<std::uint16_t> analog_in[TOTAL_PINS];
+	/* PWM is written from loop() and from the BLE write handler. */
+	std::atomic<std::uint32_t> pwm_value[TOTAL_PINS];
+	std::atomic<std::uint32_t> pwm_hz[TOTAL_PINS];
+	std::uint8_t eeprom[shim_eeprom_size];
+
+	LogLevel log_level;
+	bool ble_connected;
+	bool ble_advertising;
+};
+
+shim_hw_t &shim_hw();
+
+std::uint32_t millis();
+std::uint32_t micros();
+void delay(std::uint32_t ms);
+
+inline void pinMode(pin_t pin, PinMode mode)
+{
+	if (pin < TOTAL_PINS)
+	{
+		shim_hw().pin_mode[pin] = mode;
+		shim_hw().digital_in[pin] = (mode == INPUT_PULLUP) ? HIGH : LOW;
+	}
+}
+
+inline std::int32_t digitalRead(pin_t pin)
+{
+	return (pin < TOTAL_PINS) ? shim_hw().digital_in[pin].load() : LOW;
+}
+
+inline void digitalWrite(pin_t pin, std::uint8_t value)
+{
+	if (pin < TOTAL_PINS)
+	{
+		shim_hw().digital_out[pin] = value;
+	}
+}
+
+inline std::int32_t analogRead(pin_t pin)
+{
+	return (pin < TOTAL_PINS) ? shim_hw().analog_in[pin].load() : 0;
+}
+
+inline void analogWrite(pin_t pin, std::uint32_t value, std::uint32_t hz = 500u)
+{
+	if (pin < TOTAL_PINS)
+	{
+		shim_hw().pwm_value[pin] = value;
+		shim_hw().pwm_hz[pin] = hz;
+	}
+}
+
+/**
+ * @brief printf-style logger standing in for Device OS Log.
+ */
+class Logger final
+{
+public:
+	void trace(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+	void info(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+	void warn(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+	void error(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+};
+
+extern const Logger Log;
+
+class SerialLogHandler final
+{
+public:
+	explicit SerialLogHandler(LogLevel level = LOG_LEVEL_INFO)
+	{
+		shim_hw().log_level = level;
+	}
+};
+
+/**
+ * @brief 128-bit UUID kept in its string form.
+ */
+class BleUuid final
+{
+public:
+	BleUuid() : text_{} {}
+
+	BleUuid(const char *uuid) : text_{}
+	{
+		if (uuid != nullptr)
+		{
+			std::strncpy(text_, uuid, sizeof(text_) - 1u);
+		}
+	}
+
+	bool operator==(const BleUuid &other) const
+	{
+		return std::strcmp(text_, other.text_) == 0;
+	}
+
+	const char *toString() const
+	{
+		return text_;
+	}
+
+private:
+	char text_[37];
+};
+
+enum class BleCharacteristicProperty : std::uint8_t
+{
+	NONE = 0u,
+	READ = 0x02u,
+	WRITE_WO_RSP = 0x04u,
+	WRITE = 0x08u,
+	NOTIFY = 0x10u,
+	INDICATE = 0x20u
+};
+
+inline constexpr BleCharacteristicProperty operator|(BleCharacteristicProperty a,
+						     BleCharacteristicProperty b)
+{
+	return static_cast<BleCharacteristicProperty>(
+	    static_cast<std::uint8_t>(a) | static_cast<std::uint8_t>(b));
+}
+
+class BlePeerDevice final
+{
+};
+
+typedef void (*BleOnDataReceivedCallback)(const std::uint8_t *data,
+					  std::size_t len,
+					  const BlePeerDevice &peer,
+					  void *context);
+
+/**
+ * @brief Characteristic handle; notifications are forwarded to the shim.
+ */
+class BleCharacteristic final
+{
+public:
+	BleCharacteristic(const char *description,
+			  BleCharacteristicProperty properties,
+			  BleUuid uuid,
+			  BleUuid service,
+			  BleOnDataReceivedCallback callback = nullptr,
+			  void *context = nullptr)
+	    : description_(description), properties_(properties), uuid_(uuid),
+	      service_(service), callback_(callback), context_(context)
+	{
+	}
+
+	ssize_t setValue(const std::uint8_t *data, std::size_t len);
+
+	const char *description() const
+	{
+		return description_;
+	}
+
+	const BleUuid &UUID() const
+	{
+		return uuid_;
+	}
+
+	BleCharacteristicProperty properties() const
+	{
+		return properties_;
+	}
+
+	/* Test side: deliver a central's write to the firmware callback. */
+	void shim_write(const std::uint8_t *data, std::size_t len) const
+	{
+		if (callback_ != nullptr)
+		{
+			callback_(data, len, BlePeerDevice{}, context_);
+		}
+	}
+
+private:
+	const char *description_;
+	BleCharacteristicProperty properties_;
+	BleUuid uuid_;
+	BleUuid service_;
+	BleOnDataReceivedCallback callback_;
+	void *context_;
+};
+
+class BleAdvertisingData final
+{
+public:
+	std::size_t appendServiceUUID(const BleUuid &uuid)
+	{
+		service_ = uuid;
+		return 16u;
+	}
+
+private:
+	BleUuid service_;
+};
+
+class BleLocalDevice final
+{
+public:
+	BleCharacteristic addCharacteristic(BleCharacteristic &characteristic);
+	int advertise(const BleAdvertisingData *data);
+	bool connected() const
+	{
+		return shim_hw().ble_connected;
+	}
+};
+
+extern BleLocalDevice BLE;
+
+/**
+ * @brief Emulated EEPROM; out-of-range accesses are ignored like Device OS.
+ */
+class EEPROMClass final
+{
+public:
+	template <typename T>
+	T &get(int address, T &value) const
+	{
+		if ((address >= 0) && ((static_cast<std::size_t>(address) + sizeof(T)) <= shim_eeprom_size))
+		{
+			std::memcpy(&value, shim_hw().eeprom + address, sizeof(T));
+		}
+		return value;
+	}
+
+	template <typename T>
+	const T &put(int address, const T &value)
+	{
+		if ((address >= 0) && ((static_cast<std::size_t>(address) + sizeof(T)) <= shim_eeprom_size))
+		{
+			std::memcpy(shim_hw().eeprom + address, &value, sizeof(T));
+		}
+		return value;
+	}
+
+	std::size_t length() const
+	{
+		return shim_eeprom_size;
+	}
+};
+
+extern EEPROMClass EEPROM;
+
+/**
+ * @brief The part of the Wiring String class the firmware uses.
+ */
+class String final
+{
+public:
+	String(const char *text) : text_(text)
+	{
+	}
+
+	const char *c_str() const
+	{
+		return text_.c_str();
+	}
+
+private:
+	std::string text_;
+};
+
+/**
+ * @brief Cloud functions and calculated variables are registered but
+ *	  only evaluated by shim_cloud_call() and shim_cloud_get().
+ */
+class CloudClass final
+{
+public:
+	bool function(const char *name, int (*fn)(String));
+	bool variable(const char *name, String (*fn)());
+};
+
+extern CloudClass Particle;
+
+void setup();
+void loop();
+
+/*
+ * Test-side hooks (not part of Device OS).
+ */
+
+/**
+ * @brief Find a registered characteristic by UUID string.
+ * @return Characteristic, or nullptr if none was added.
+ */
+const BleCharacteristic *shim_ble_find(const char *uuid);
+
+/**
+ * @brief Receiver for notifications sent with setValue().
+ */
+typedef void (*shim_notify_fn)(void *context,
+			       const BleCharacteristic &characteristic,
+			       const std::uint8_t *data,
+			       std::size_t len);
+
+void shim_ble_on_notify(shim_notify_fn fn, void *context);
+
+/**
+ * @brief Whether millis()/micros() follow the virtual --step-us clock.
+ */
+bool shim_virtual_clock();
+
+/**
+ * @brief Hardware model run by main() before every loop() call.
+ */
+typedef void (*shim_tick_fn)(void *context);
+
+void shim_on_tick(shim_tick_fn fn, void *context);
+
+/**
+ * @brief Trace file given with --trace.
+ * @return Path, or nullptr if no trace was requested.
+ */
+const char *shim_trace_path();
+
+/**
+ * @brief Invoke a registered cloud function as the cloud would.
+ * @return The function's result, or -1 if no function has that name.
+ */
+int shim_cloud_call(const char *name, const char *arg);
+
+/**
+ * @brief Read a calculated cloud variable as the cloud would.
+ * @return true if a variable has that name, otherwise false.
+ */
+bool shim_cloud_get(const char *name, std::string &value);
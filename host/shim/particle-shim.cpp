@@ -0,0 +1,628 @@
+/**
+ * @file	particle-shim.cpp
+ * @brief	Native runner for Particle firmware built against host/shim
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Provides main(): calls setup() once, then loop() repeatedly while
+ * driving the simulated pins, and times every loop() call with the
+ * cycle counter (rdtsc on x86, steady_clock elsewhere). At exit it
+ * prints the loop latency distribution and the BLE traffic seen.
+ *
+ * millis() either follows the wall clock (default) or a virtual clock
+ * advanced by --step-us per loop() call, which makes runs repeatable and
+ * independent of machine speed. --control-hz starts a second thread
+ * that writes control packets to the control characteristic, standing
+ * in for the Device OS BLE thread. --call invokes a cloud function
+ * registered with Particle.function() once, after setup(). --get prints
+ * a Particle.variable() at exit; with --get-hz a further thread also
+ * reads it at that rate during the run, as cloud requests on the system
+ * thread would. --trace records a replay trace of the run
+ * (host/replay/sn2-trace-recorder.hpp). EEPROM starts erased (all 0xFF)
+ * on every run.
+ *
+ * Usage:
+ *	sn2-native [--loops N] [--step-us U] [--control-hz F]
+ *		   [--analog PIN=V] [--noise N] [--seed N] [--disconnected]
+ *		   [--call NAME=ARG] [--get NAME [--get-hz F]] [--trace FILE]
+ *		   [--verbose]
+ */
+
+#include "Particle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "../../protocol/ble-protocol.hpp"
+
+namespace
+{
+
+/**
+ * @brief Registered characteristics (Device OS allows a few dozen).
+ */
+struct shim_ble_t final
+{
+	static constexpr std::size_t characteristics_max = 16u;
+
+	const BleCharacteristic *characteristics[characteristics_max];
+	std::size_t count;
+	shim_notify_fn notify;
+	void *notify_context;
+};
+
+/**
+ * @brief Registered cloud functions and calculated variables.
+ */
+struct shim_cloud_t final
+{
+	static constexpr std::size_t functions_max = 15u;
+	static constexpr std::size_t variables_max = 20u;
+
+	const char *names[functions_max];
+	int (*functions[functions_max])(String);
+	std::size_t count;
+
+	const char *variable_names[variables_max];
+	String (*variables[variables_max])();
+	std::size_t variable_count;
+};
+
+/**
+ * @brief Command-line options.
+ */
+struct shim_options_t final
+{
+	std::uint64_t loops;
+	std::uint32_t step_us;
+	double control_hz;
+	double get_hz;
+	std::uint16_t noise;
+	std::uint32_t seed;
+	bool connected;
+	bool verbose;
+};
+
+shim_hw_t g_hw{};
+shim_ble_t g_ble{};
+shim_cloud_t g_cloud{};
+
+std::atomic<std::uint64_t> g_virtual_us{0u};
+bool g_virtual_clock = false;
+shim_tick_fn g_tick = nullptr;
+void *g_tick_context = nullptr;
+const char *g_trace_path = nullptr;
+const auto g_start = std::chrono::steady_clock::now();
+
+std::atomic<std::uint64_t> g_notifications{0u};
+std::atomic<std::uint64_t> g_notify_bytes{0u};
+
+std::uint64_t shim_elapsed_us()
+{
+	std::uint64_t us = 0u;
+
+	if (g_virtual_clock)
+	{
+		us = g_virtual_us.load(std::memory_order_relaxed);
+	}
+	else
+	{
+		us = static_cast<std::uint64_t>(
+		    std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - g_start)
+			.count());
+	}
+
+	return us;
+}
+
+inline std::uint64_t shim_cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return static_cast<std::uint64_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch())
+		.count());
+#endif
+}
+
+void shim_log(LogLevel level, const char *tag, const char *fmt, std::va_list args)
+{
+	if (level >= g_hw.log_level)
+	{
+		std::fprintf(stderr, "%010u [app] %s: ", millis(), tag);
+		std::vfprintf(stderr, fmt, args);
+		std::fprintf(stderr, "\n");
+	}
+}
+
+const char *shim_option(int argc, char **argv, const char *name,
+			const char *fallback)
+{
+	const char *value = fallback;
+
+	for (int i = 1; (i + 1) < argc; ++i)
+	{
+		if (std::strcmp(argv[i], name) == 0)
+		{
+			value = argv[i + 1];
+		}
+	}
+
+	return value;
+}
+
+bool shim_flag(int argc, char **argv, const char *name)
+{
+	bool found = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		found = found || (std::strcmp(argv[i], name) == 0);
+	}
+
+	return found;
+}
+
+std::uint32_t shim_rand(std::uint32_t &state)
+{
+	std::uint32_t x = state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	state = x;
+
+	return x;
+}
+
+/* Stand-in for the BLE thread: periodic override writes from a central. */
+void shim_control_peer(double hz, std::uint32_t seed, std::atomic<bool> &stop)
+{
+	const BleCharacteristic *control = shim_ble_find(ble_uuid_t::control);
+	const auto period = std::chrono::duration<double>(1.0 / hz);
+	auto due = std::chrono::steady_clock::now();
+	std::uint32_t rng = seed | 1u;
+
+	while ((control != nullptr) && !stop.load(std::memory_order_relaxed))
+	{
+		const control_packet_t pkt = ble_make_control(
+		    ble_node_id_t::sn2,
+		    static_cast<std::uint16_t>(shim_rand(rng) & 1u),
+		    static_cast<std::uint16_t>(shim_rand(rng) % 1001u));
+		std::uint8_t bytes[sizeof(control_packet_t)];
+
+		if (ble_pack_control(bytes, sizeof(bytes), pkt))
+		{
+			control->shim_write(bytes, sizeof(bytes));
+		}
+		due += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		    period);
+		std::this_thread::sleep_until(due);
+	}
+}
+
+/* Stand-in for the system thread serving cloud variable requests. */
+void shim_cloud_reader(const char *name, double hz, std::atomic<bool> &stop)
+{
+	const auto period = std::chrono::duration<double>(1.0 / hz);
+	auto due = std::chrono::steady_clock::now();
+	std::string value;
+
+	while (!stop.load(std::memory_order_relaxed) && shim_cloud_get(name, value))
+	{
+		due += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		    period);
+		std::this_thread::sleep_until(due);
+	}
+}
+
+void shim_count_notify(void *context, const BleCharacteristic &characteristic,
+		       const std::uint8_t *data, std::size_t len)
+{
+	const bool verbose = *static_cast<const bool *>(context);
+
+	g_notifications.fetch_add(1u, std::memory_order_relaxed);
+	g_notify_bytes.fetch_add(len, std::memory_order_relaxed);
+	if (verbose)
+	{
+		std::printf("%010u notify %-9s", millis(), characteristic.description());
+		for (std::size_t i = 0u; i < len; ++i)
+		{
+			std::printf(" %02x", data[i]);
+		}
+		std::printf("\n");
+	}
+}
+
+void shim_report(std::vector<std::uint32_t> &samples, double wall_s,
+		 std::uint64_t total_cycles)
+{
+	const double cycles_per_ns =
+	    (wall_s > 0.0) ? (static_cast<double>(total_cycles) / (wall_s * 1.0e9))
+			   : 1.0;
+	const std::size_t n = samples.size();
+	std::uint64_t sum = 0u;
+
+	if (n == 0u)
+	{
+		return;
+	}
+
+	for (const std::uint32_t s : samples)
+	{
+		sum += s;
+	}
+	std::sort(samples.begin(), samples.end());
+
+	const auto pct = [&](double p) {
+		return samples[std::min(n - 1u, static_cast<std::size_t>(
+						   p * static_cast<double>(n)))];
+	};
+	const auto line = [&](const char *name, double cycles) {
+		std::printf("  %-6s %12.0f cycles %12.1f ns\n", name, cycles,
+			    cycles / cycles_per_ns);
+	};
+
+	std::printf("%zu loop() calls in %.3f s wall, %.2f cycles/ns\n", n, wall_s,
+		    cycles_per_ns);
+	line("min", samples.front());
+	line("mean", static_cast<double>(sum) / static_cast<double>(n));
+	line("p50", pct(0.50));
+	line("p99", pct(0.99));
+	line("p99.9", pct(0.999));
+	line("max", samples.back());
+	std::printf("loop() busy %.1f%% of wall time\n",
+		    (100.0 * static_cast<double>(sum)) /
+			static_cast<double>(std::max<std::uint64_t>(total_cycles, 1u)));
+	std::printf("%llu notifications, %llu bytes\n",
+		    static_cast<unsigned long long>(g_notifications.load()),
+		    static_cast<unsigned long long>(g_notify_bytes.load()));
+}
+
+} // namespace
+
+const Logger Log;
+BleLocalDevice BLE;
+EEPROMClass EEPROM;
+CloudClass Particle;
+
+shim_hw_t &shim_hw()
+{
+	return g_hw;
+}
+
+std::uint32_t millis()
+{
+	return static_cast<std::uint32_t>(shim_elapsed_us() / 1000u);
+}
+
+std::uint32_t micros()
+{
+	return static_cast<std::uint32_t>(shim_elapsed_us());
+}
+
+void delay(std::uint32_t ms)
+{
+	if (g_virtual_clock)
+	{
+		g_virtual_us.fetch_add(static_cast<std::uint64_t>(ms) * 1000u,
+				       std::memory_order_relaxed);
+	}
+	else
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+	}
+}
+
+void Logger::trace(const char *fmt, ...) const
+{
+	std::va_list args;
+
+	va_start(args, fmt);
+	shim_log(LOG_LEVEL_TRACE, "TRACE", fmt, args);
+	va_end(args);
+}
+
+void Logger::info(const char *fmt, ...) const
+{
+	std::va_list args;
+
+	va_start(args, fmt);
+	shim_log(LOG_LEVEL_INFO, "INFO", fmt, args);
+	va_end(args);
+}
+
+void Logger::warn(const char *fmt, ...) const
+{
+	std::va_list args;
+
+	va_start(args, fmt);
+	shim_log(LOG_LEVEL_WARN, "WARN", fmt, args);
+	va_end(args);
+}
+
+void Logger::error(const char *fmt, ...) const
+{
+	std::va_list args;
+
+	va_start(args, fmt);
+	shim_log(LOG_LEVEL_ERROR, "ERROR", fmt, args);
+	va_end(args);
+}
+
+ssize_t BleCharacteristic::setValue(const std::uint8_t *data, std::size_t len)
+{
+	if (g_ble.notify != nullptr)
+	{
+		g_ble.notify(g_ble.notify_context, *this, data, len);
+	}
+
+	return static_cast<ssize_t>(len);
+}
+
+BleCharacteristic BleLocalDevice::addCharacteristic(BleCharacteristic &characteristic)
+{
+	if (g_ble.count < shim_ble_t::characteristics_max)
+	{
+		g_ble.characteristics[g_ble.count] = &characteristic;
+		++g_ble.count;
+	}
+
+	return characteristic;
+}
+
+int BleLocalDevice::advertise(const BleAdvertisingData *data)
+{
+	g_hw.ble_advertising = data != nullptr;
+
+	return 0;
+}
+
+const BleCharacteristic *shim_ble_find(const char *uuid)
+{
+	const BleCharacteristic *found = nullptr;
+	const BleUuid key(uuid);
+
+	for (std::size_t i = 0u; (i < g_ble.count) && (found == nullptr); ++i)
+	{
+		if (g_ble.characteristics[i]->UUID() == key)
+		{
+			found = g_ble.characteristics[i];
+		}
+	}
+
+	return found;
+}
+
+void shim_ble_on_notify(shim_notify_fn fn, void *context)
+{
+	g_ble.notify = fn;
+	g_ble.notify_context = context;
+}
+
+bool shim_virtual_clock()
+{
+	return g_virtual_clock;
+}
+
+void shim_on_tick(shim_tick_fn fn, void *context)
+{
+	g_tick = fn;
+	g_tick_context = context;
+}
+
+const char *shim_trace_path()
+{
+	return g_trace_path;
+}
+
+bool CloudClass::function(const char *name, int (*fn)(String))
+{
+	const bool ok = g_cloud.count < shim_cloud_t::functions_max;
+
+	if (ok)
+	{
+		g_cloud.names[g_cloud.count] = name;
+		g_cloud.functions[g_cloud.count] = fn;
+		++g_cloud.count;
+	}
+
+	return ok;
+}
+
+bool CloudClass::variable(const char *name, String (*fn)())
+{
+	const bool ok = g_cloud.variable_count < shim_cloud_t::variables_max;
+
+	if (ok)
+	{
+		g_cloud.variable_names[g_cloud.variable_count] = name;
+		g_cloud.variables[g_cloud.variable_count] = fn;
+		++g_cloud.variable_count;
+	}
+
+	return ok;
+}
+
+bool shim_cloud_get(const char *name, std::string &value)
+{
+	bool ok = false;
+
+	for (std::size_t i = 0u; i < g_cloud.variable_count; ++i)
+	{
+		if (std::strcmp(g_cloud.variable_names[i], name) == 0)
+		{
+			value = g_cloud.variables[i]().c_str();
+			ok = true;
+		}
+	}
+
+	return ok;
+}
+
+int shim_cloud_call(const char *name, const char *arg)
+{
+	int rc = -1;
+
+	for (std::size_t i = 0u; i < g_cloud.count; ++i)
+	{
+		if (std::strcmp(g_cloud.names[i], name) == 0)
+		{
+			rc = g_cloud.functions[i](String(arg));
+		}
+	}
+
+	return rc;
+}
+
+int main(int argc, char **argv)
+{
+	shim_options_t opt{};
+	std::uint16_t analog_base[TOTAL_PINS];
+	std::atomic<bool> stop{false};
+
+	opt.loops = std::strtoull(shim_option(argc, argv, "--loops", "1000000"),
+				  nullptr, 0);
+	opt.step_us = static_cast<std::uint32_t>(
+	    std::strtoul(shim_option(argc, argv, "--step-us", "0"), nullptr, 0));
+	opt.control_hz = std::strtod(shim_option(argc, argv, "--control-hz", "0"),
+				     nullptr);
+	opt.get_hz = std::strtod(shim_option(argc, argv, "--get-hz", "0"), nullptr);
+	opt.noise = static_cast<std::uint16_t>(
+	    std::strtoul(shim_option(argc, argv, "--noise", "32"), nullptr, 0));
+	opt.seed = static_cast<std::uint32_t>(
+	    std::strtoul(shim_option(argc, argv, "--seed", "1"), nullptr, 0));
+	opt.connected = !shim_flag(argc, argv, "--disconnected");
+	opt.verbose = shim_flag(argc, argv, "--verbose");
+	g_trace_path = shim_option(argc, argv, "--trace", nullptr);
+
+	std::fill(analog_base, analog_base + TOTAL_PINS, 2048u);
+	for (int i = 1; (i + 1) < argc; ++i)
+	{
+		unsigned pin = 0u;
+		unsigned value = 0u;
+
+		if ((std::strcmp(argv[i], "--analog") == 0) &&
+		    (std::sscanf(argv[i + 1], "%u=%u", &pin, &value) == 2) &&
+		    (pin < TOTAL_PINS))
+		{
+			analog_base[pin] = static_cast<std::uint16_t>(std::min(value, 4095u));
+		}
+	}
+
+	g_virtual_clock = opt.step_us != 0u;
+	g_hw.ble_connected = opt.connected;
+	std::fill(g_hw.eeprom, g_hw.eeprom + shim_eeprom_size, 0xFFu);
+	shim_ble_on_notify(shim_count_notify, &opt.verbose);
+
+	setup();
+
+	if (const char *call = shim_option(argc, argv, "--call", nullptr))
+	{
+		const char *eq = std::strchr(call, '=');
+		const std::string name(call, (eq != nullptr) ? static_cast<std::size_t>(eq - call)
+							    : std::strlen(call));
+
+		std::printf("%s(\"%s\") = %d\n", name.c_str(), (eq != nullptr) ? eq + 1 : "",
+			    shim_cloud_call(name.c_str(), (eq != nullptr) ? eq + 1 : ""));
+	}
+
+	std::thread peer;
+	if (opt.control_hz > 0.0)
+	{
+		peer = std::thread(shim_control_peer, opt.control_hz, opt.seed, std::ref(stop));
+	}
+
+	const char *get = shim_option(argc, argv, "--get", nullptr);
+	std::thread reader;
+	if ((get != nullptr) && (opt.get_hz > 0.0))
+	{
+		reader = std::thread(shim_cloud_reader, get, opt.get_hz, std::ref(stop));
+	}
+
+	std::vector<std::uint32_t> samples;
+	std::uint32_t rng = opt.seed | 1u;
+
+	samples.reserve(static_cast<std::size_t>(opt.loops));
+	const auto wall_start = std::chrono::steady_clock::now();
+	const std::uint64_t cycles_start = shim_cycles();
+
+	for (std::uint64_t i = 0u; i < opt.loops; ++i)
+	{
+		for (pin_t pin = 0u; pin < TOTAL_PINS; ++pin)
+		{
+			const std::int32_t jitter =
+			    (opt.noise != 0u)
+				? (static_cast<std::int32_t>(shim_rand(rng) %
+							     (2u * opt.noise + 1u)) -
+				   static_cast<std::int32_t>(opt.noise))
+				: 0;
+
+			g_hw.analog_in[pin] = static_cast<std::uint16_t>(std::clamp(
+			    static_cast<std::int32_t>(analog_base[pin]) + jitter, 0, 4095));
+		}
+
+		if (g_tick != nullptr)
+		{
+			g_tick(g_tick_context);
+		}
+
+		const std::uint64_t t0 = shim_cycles();
+		loop();
+		const std::uint64_t t1 = shim_cycles();
+
+		samples.push_back(static_cast<std::uint32_t>(
+		    std::min<std::uint64_t>(t1 - t0, 0xFFFFFFFFu)));
+		if (g_virtual_clock)
+		{
+			g_virtual_us.fetch_add(opt.step_us, std::memory_order_relaxed);
+		}
+	}
+
+	const std::uint64_t cycles_total = shim_cycles() - cycles_start;
+	const double wall_s = std::chrono::duration<double>(
+				  std::chrono::steady_clock::now() - wall_start)
+				  .count();
+
+	stop.store(true, std::memory_order_relaxed);
+	if (peer.joinable())
+	{
+		peer.join();
+	}
+	if (reader.joinable())
+	{
+		reader.join();
+	}
+
+	shim_report(samples, wall_s, cycles_total);
+	if (get != nullptr)
+	{
+		std::string value;
+
+		if (shim_cloud_get(get, value))
+		{
+			std::printf("%s = %s\n", get, value.c_str());
+		}
+		else
+		{
+			std::printf("%s: no such variable\n", get);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file	sn2-acquire-port-fake.cpp
+ * @brief	Host fake of the acquisition port
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Replaces src/sn2-acquire-port.cpp in native builds. Whole blocks of
+ * sn2-sound-synth.hpp samples are committed to the ring as the shim
+ * clock (micros()) advances, each with a scan of the simulated pins
+ * (--analog, --noise) taken through the shim's analogRead() and
+ * digitalRead(). On the wall clock a detached thread produces them,
+ * standing in for the port thread; on the virtual --step-us clock they
+ * are produced before every loop() call (shim_on_tick()), so runs stay
+ * repeatable.
+ */
+
+#include "Particle.h"
+
+#include <chrono>
+#include <thread>
+
+#include "../../src/sn2-acquire.hpp"
+#include "sn2-sound-synth.hpp"
+
+namespace
+{
+
+/**
+ * @brief Fake port state.
+ */
+struct acquire_fake_t final
+{
+	sn2_acquire_t *acq;
+	sound_synth_t synth;
+	std::uint64_t produced_us;
+};
+
+acquire_fake_t g_fake;
+
+/* Commit every block that completed by the shim clock's current time. */
+void acquire_fake_produce(void *context)
+{
+	constexpr std::uint32_t block_us = static_cast<std::uint32_t>(
+	    (1000000u * sn2_sound_constants_t::block_samples) /
+	    sn2_sound_constants_t::sample_rate_hz);
+	acquire_fake_t &fake = *static_cast<acquire_fake_t *>(context);
+	sn2_acquire_t &acq = *fake.acq;
+
+	/* micros() is 32-bit; compare wrap-safely. */
+	while (static_cast<std::int32_t>(
+		   micros() - static_cast<std::uint32_t>(fake.produced_us + block_us)) >= 0)
+	{
+		std::uint16_t *block = sn2_sampler_fill(acq.ring);
+
+		for (std::size_t i = 0u; i < sn2_sound_constants_t::block_samples; ++i)
+		{
+			block[i] = sound_synth_sample(fake.synth);
+		}
+		fake.produced_us += block_us;
+		(void)sn2_sampler_commit(
+		    acq.ring,
+		    sn2_acquire_scan(acq, static_cast<std::uint32_t>(fake.produced_us / 1000u),
+				     [](std::uint16_t pin) { return analogRead(pin); },
+				     [](std::uint16_t pin) { return digitalRead(pin) == HIGH; }));
+	}
+}
+
+void acquire_fake_thread(acquire_fake_t *fake)
+{
+	for (;;)
+	{
+		acquire_fake_produce(fake);
+		std::this_thread::sleep_for(std::chrono::microseconds(500));
+	}
+}
+
+} // namespace
+
+bool sn2_acquire_port_start(sn2_acquire_t &acq)
+{
+	g_fake.acq = &acq;
+	g_fake.produced_us = micros();
+	sound_synth_init(g_fake.synth, 0x5EED5u);
+	if (shim_virtual_clock())
+	{
+		shim_on_tick(acquire_fake_produce, &g_fake);
+	}
+	else
+	{
+		std::thread(acquire_fake_thread, &g_fake).detach();
+	}
+
+	return true;
+}
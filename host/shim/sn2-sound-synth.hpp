@@ -0,0 +1,86 @@
+/**
+ * @file	sn2-sound-synth.hpp
+ * @brief	Synthetic microphone signal for host tools
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Mid-scale ADC noise with tone bursts (300-1500 Hz, 200-1500 ms, on
+ * average every 30 s) standing in for sound events. Shared by the
+ * native build's fake sampling port and the replay trace generator so
+ * both see the same kind of input.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "../../src/sn2-sound.hpp"
+
+/**
+ * @brief Signal generator state.
+ */
+struct sound_synth_t final
+{
+	std::uint32_t rng;
+	std::uint64_t sample_index;
+	std::uint64_t burst_end;
+	double burst_amplitude;
+	double burst_step;
+};
+
+/**
+ * @brief Initialise a generator.
+ */
+static inline void sound_synth_init(sound_synth_t &synth, std::uint32_t seed)
+{
+	synth = sound_synth_t{};
+	synth.rng = seed | 1u;
+}
+
+static inline std::uint32_t sound_synth_rand(std::uint32_t &state)
+{
+	std::uint32_t x = state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	state = x;
+
+	return x;
+}
+
+/**
+ * @brief Next ADC sample at sn2_sound_constants_t::sample_rate_hz.
+ */
+static inline std::uint16_t sound_synth_sample(sound_synth_t &synth)
+{
+	constexpr std::uint32_t rate = sn2_sound_constants_t::sample_rate_hz;
+	double value = 2048.0 + static_cast<double>(static_cast<std::int32_t>(
+				    sound_synth_rand(synth.rng) % 121u) -
+				60);
+
+	if ((synth.sample_index >= synth.burst_end) &&
+	    ((sound_synth_rand(synth.rng) % (30u * rate)) == 0u))
+	{
+		synth.burst_end = synth.sample_index + ((rate * 200u) / 1000u) +
+				  (sound_synth_rand(synth.rng) % ((rate * 1300u) / 1000u));
+		synth.burst_amplitude =
+		    600.0 + static_cast<double>(sound_synth_rand(synth.rng) % 900u);
+		synth.burst_step = (2.0 * 3.14159265358979323846 *
+				    (300.0 + static_cast<double>(
+						 sound_synth_rand(synth.rng) % 1200u))) /
+				   static_cast<double>(rate);
+	}
+	if (synth.sample_index < synth.burst_end)
+	{
+		value += synth.burst_amplitude *
+			 std::sin(synth.burst_step * static_cast<double>(synth.sample_index));
+	}
+	++synth.sample_index;
+
+	return static_cast<std::uint16_t>(
+	    std::lround(std::fmin(std::fmax(value, 0.0), 4095.0)));
+}
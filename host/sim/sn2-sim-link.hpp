@@ -0,0 +1,117 @@
+/**
+ * @file	sn2-sim-link.hpp
+ * @brief	Local datagram framing between simulated nodes and a host CN
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * The SN2 simulator replaces the BLE link with a UNIX datagram socket.
+ * Each datagram carries one characteristic payload prefixed by a small
+ * envelope naming the simulated node instance and the characteristic,
+ * so a single socket can multiplex hundreds of simulated peripherals.
+ *
+ * Envelope layout (little-endian):
+ * - instance		uint16, simulated node index
+ * - characteristic	uint8, sim_characteristic_t
+ * - payload		raw BLE characteristic bytes
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../../protocol/ble-protocol.hpp"
+
+/**
+ * @brief Characteristic carried by a simulator datagram.
+ */
+enum class sim_characteristic_t : std::uint8_t
+{
+	telemetry = 1u,
+	event = 2u,
+	control = 3u,
+	telemetry_batch = 4u,
+	telemetry_stream = 5u
+};
+
+/**
+ * @brief Simulator link framing constants.
+ */
+struct sim_link_constants_t final
+{
+	static constexpr std::size_t envelope_size = 3u;
+	static constexpr std::size_t datagram_max =
+	    envelope_size + ble_protocol_constants_t::notify_payload_max;
+};
+
+/**
+ * @brief Wrap a characteristic payload in a simulator envelope.
+ * @param dst Destination buffer.
+ * @param dst_size Destination buffer size in bytes.
+ * @param instance Simulated node index.
+ * @param characteristic Characteristic the payload belongs to.
+ * @param payload Payload bytes.
+ * @param payload_size Payload size in bytes.
+ * @return Datagram size in bytes, or 0 if it does not fit.
+ */
+static inline std::size_t sim_link_wrap(
+    std::uint8_t *dst,
+    std::size_t dst_size,
+    std::uint16_t instance,
+    sim_characteristic_t characteristic,
+    const std::uint8_t *payload,
+    std::size_t payload_size)
+{
+	std::size_t size = 0u;
+
+	if ((dst != nullptr) && (payload != nullptr) &&
+	    (dst_size >= (sim_link_constants_t::envelope_size + payload_size)))
+	{
+		ble_store_le<std::uint16_t>(dst, instance);
+		dst[2] = static_cast<std::uint8_t>(characteristic);
+		std::memcpy(dst + sim_link_constants_t::envelope_size, payload,
+			    payload_size);
+		size = sim_link_constants_t::envelope_size + payload_size;
+	}
+
+	return size;
+}
+
+/**
+ * @brief Split a simulator datagram into envelope and payload.
+ * @param src Datagram bytes.
+ * @param src_size Datagram size in bytes.
+ * @param instance Simulated node index.
+ * @param characteristic Characteristic the payload belongs to.
+ * @param payload Payload start (points into src).
+ * @param payload_size Payload size in bytes.
+ * @return true if the datagram holds an envelope, otherwise false.
+ */
+static inline bool sim_link_unwrap(
+    const std::uint8_t *src,
+    std::size_t src_size,
+    std::uint16_t &instance,
+    sim_characteristic_t &characteristic,
+    const std::uint8_t *&payload,
+    std::size_t &payload_size)
+{
+	bool ok = true;
+
+	if ((src == nullptr) || (src_size < sim_link_constants_t::envelope_size))
+	{
+		ok = false;
+	}
+	else
+	{
+		instance = ble_load_le<std::uint16_t>(src);
+		characteristic = static_cast<sim_characteristic_t>(src[2]);
+		payload = src + sim_link_constants_t::envelope_size;
+		payload_size = src_size - sim_link_constants_t::envelope_size;
+		ok = true;
+	}
+
+	return ok;
+}
@@ -0,0 +1,614 @@
+/**
+ * @file	sn2-sim.cpp
+ * @brief	Host-side simulator of many SN2 nodes speaking the BLE protocol
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Simulates any number of Sensor Node 2 instances in one process so a
+ * control node implementation can be load-tested without hardware. Each
+ * instance generates temperature, sound and potentiometer traces, emits
+ * telemetry every telemetry_period_ms, raises help/sound events subject
+ * to event_lockout_ms, and applies control_packet_t writes.
+ *
+ * The BLE link is replaced by a UNIX datagram socket using the envelope
+ * defined in sn2-sim-link.hpp. Packets are produced with the shared
+ * protocol header, so the bytes on the socket are exactly the bytes a
+ * real SN2 would notify.
+ *
+ * Usage:
+ *	sn2-sim [--nodes N] [--bind PATH] [--central PATH]
+ *		[--duration S] [--speed X] [--seed N]
+ *
+ * --speed scales virtual time against wall time; 0 runs as fast as the
+ * CPU allows, which is the mode used for central-side throughput tests.
+ * Sends block while the central's socket queue is full, so a slow
+ * central applies back-pressure instead of silently losing packets.
+ */
+
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../../protocol/ble-protocol.hpp"
+#include "sn2-sim-link.hpp"
+
+namespace
+{
+
+/**
+ * @brief Simulator tuning constants.
+ */
+struct sim_constants_t final
+{
+	static constexpr std::uint32_t tick_ms = 10u;
+	static constexpr std::uint16_t adc_max = 4095u;
+	static constexpr std::size_t nodes_max = 65535u;
+
+	/* Mean intervals of the random processes, in milliseconds. */
+	static constexpr double sound_burst_mean_ms = 30000.0;
+	static constexpr double help_press_mean_ms = 600000.0;
+	static constexpr double pot_step_mean_ms = 60000.0;
+
+	static constexpr double day_ms = 86400000.0;
+	static constexpr double pi = 3.14159265358979323846;
+};
+
+/**
+ * @brief Command-line options.
+ */
+struct sim_options_t final
+{
+	std::size_t nodes;
+	const char *bind_path;
+	const char *central_path;
+	double duration_s;
+	double speed;
+	std::uint32_t seed;
+};
+
+/**
+ * @brief Run statistics.
+ */
+struct sim_stats_t final
+{
+	std::uint64_t telemetry_sent;
+	std::uint64_t events_sent;
+	std::uint64_t send_failures;
+	std::uint64_t controls_applied;
+	std::uint64_t controls_rejected;
+};
+
+/**
+ * @brief State of one simulated SN2 instance.
+ */
+struct sim_node_t final
+{
+	std::uint32_t rng;
+
+	double temp_base_centi;
+	double temp_walk_centi;
+	double day_phase;
+
+	std::uint32_t sound_until_ms;
+	std::int16_t sound_level;
+	bool sound_state;
+
+	std::uint16_t pot_raw;
+	bool help_active;
+	bool override_active;
+	std::uint16_t duty_override;
+
+	std::uint32_t next_telemetry_ms;
+	std::uint32_t last_help_event_ms;
+	std::uint32_t last_sound_event_ms;
+	bool help_event_armed;
+	bool sound_event_armed;
+};
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void sim_on_signal(int)
+{
+	g_stop = 1;
+}
+
+/**
+ * @brief xorshift32 step; cheap and deterministic per node.
+ */
+std::uint32_t sim_rand(std::uint32_t &state)
+{
+	std::uint32_t x = state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	state = x;
+
+	return x;
+}
+
+/**
+ * @brief Uniform double in [0, 1).
+ */
+double sim_uniform(std::uint32_t &state)
+{
+	return static_cast<double>(sim_rand(state)) / 4294967296.0;
+}
+
+/**
+ * @brief Bernoulli trial for a Poisson process over one tick.
+ */
+bool sim_chance(std::uint32_t &state, double mean_interval_ms)
+{
+	return sim_uniform(state) <
+	       (static_cast<double>(sim_constants_t::tick_ms) / mean_interval_ms);
+}
+
+/**
+ * @brief Check whether a millis()-style deadline has been reached.
+ */
+bool sim_time_reached(std::uint32_t now_ms, std::uint32_t deadline_ms)
+{
+	return static_cast<std::int32_t>(now_ms - deadline_ms) >= 0;
+}
+
+void sim_node_init(sim_node_t &node, std::uint32_t seed, std::size_t index)
+{
+	node.rng = (seed ^ static_cast<std::uint32_t>(
+			       (index + 1u) * 2654435761u)) | 1u;
+
+	node.temp_base_centi = 2200.0 + (sim_uniform(node.rng) * 600.0) - 300.0;
+	node.temp_walk_centi = 0.0;
+	node.day_phase = sim_uniform(node.rng) * 2.0 * sim_constants_t::pi;
+
+	node.sound_until_ms = 0u;
+	node.sound_level = 0;
+	node.sound_state = false;
+
+	node.pot_raw = static_cast<std::uint16_t>(
+	    sim_rand(node.rng) % (sim_constants_t::adc_max + 1u));
+	node.help_active = false;
+	node.override_active = false;
+	node.duty_override = 0u;
+
+	node.next_telemetry_ms =
+	    sim_rand(node.rng) % ble_protocol_constants_t::telemetry_period_ms;
+	node.last_help_event_ms = 0u;
+	node.last_sound_event_ms = 0u;
+	node.help_event_armed = true;
+	node.sound_event_armed = true;
+}
+
+/**
+ * @brief Local duty: override if active, otherwise the potentiometer.
+ */
+std::uint16_t sim_node_duty(const sim_node_t &node)
+{
+	std::uint16_t duty = 0u;
+
+	if (node.override_active)
+	{
+		duty = node.duty_override;
+	}
+	else
+	{
+		duty = static_cast<std::uint16_t>(
+		    (static_cast<std::uint32_t>(node.pot_raw) *
+		     ble_protocol_constants_t::duty_per_mille_max) /
+		    sim_constants_t::adc_max);
+	}
+
+	return ble_clamp_duty_per_mille(duty);
+}
+
+/**
+ * @brief Current temperature in centi-degrees.
+ *
+ * Slow diurnal swing, a mean-reverting random walk, cooling proportional
+ * to fan duty and a little ADC quantisation noise.
+ */
+std::int16_t sim_node_temperature(sim_node_t &node, std::uint32_t now_ms)
+{
+	const double day = std::sin(node.day_phase +
+				    ((2.0 * sim_constants_t::pi *
+				      static_cast<double>(now_ms)) /
+				     sim_constants_t::day_ms));
+	const double cooling =
+	    static_cast<double>(sim_node_duty(node)) * 0.3;
+	const double noise = (sim_uniform(node.rng) - 0.5) * 6.0;
+
+	return static_cast<std::int16_t>(std::lround(
+	    node.temp_base_centi + (day * 150.0) + node.temp_walk_centi -
+	    cooling + noise));
+}
+
+/**
+ * @brief Send one characteristic payload through the simulator link.
+ */
+void sim_send(int fd,
+	      const sockaddr_un &central,
+	      std::uint16_t instance,
+	      sim_characteristic_t characteristic,
+	      const std::uint8_t *payload,
+	      std::size_t payload_size,
+	      sim_stats_t &stats)
+{
+	std::uint8_t datagram[sim_link_constants_t::datagram_max];
+	const std::size_t size = sim_link_wrap(datagram, sizeof(datagram),
+					       instance, characteristic,
+					       payload, payload_size);
+	const ssize_t sent =
+	    sendto(fd, datagram, size, 0,
+		   reinterpret_cast<const sockaddr *>(&central), sizeof(central));
+
+	if (sent != static_cast<ssize_t>(size))
+	{
+		++stats.send_failures;
+	}
+	else if (characteristic == sim_characteristic_t::event)
+	{
+		++stats.events_sent;
+	}
+	else
+	{
+		++stats.telemetry_sent;
+	}
+}
+
+/**
+ * @brief Emit an event if the per-type lockout allows it.
+ */
+void sim_node_event(int fd,
+		    const sockaddr_un &central,
+		    std::uint16_t instance,
+		    std::uint32_t now_ms,
+		    ble_event_type_t type,
+		    std::int16_t value,
+		    std::uint32_t &last_event_ms,
+		    bool &armed,
+		    sim_stats_t &stats)
+{
+	if (armed || ((now_ms - last_event_ms) >=
+		      ble_protocol_constants_t::event_lockout_ms))
+	{
+		const event_packet_t pkt = ble_make_event(
+		    ble_node_id_t::sn2, type, value,
+		    static_cast<std::uint16_t>(now_ms & 0xFFFFu));
+		std::uint8_t buf[sizeof(event_packet_t)];
+
+		if (ble_pack_event(buf, sizeof(buf), pkt))
+		{
+			sim_send(fd, central, instance,
+				 sim_characteristic_t::event, buf, sizeof(buf),
+				 stats);
+		}
+		last_event_ms = now_ms;
+		armed = false;
+	}
+}
+
+/**
+ * @brief Advance one node by one tick.
+ */
+void sim_node_step(sim_node_t &node,
+		   std::uint16_t instance,
+		   std::uint32_t now_ms,
+		   int fd,
+		   const sockaddr_un &central,
+		   sim_stats_t &stats)
+{
+	/* Temperature random walk, pulled back towards the base. */
+	node.temp_walk_centi += (sim_uniform(node.rng) - 0.5) * 2.0;
+	node.temp_walk_centi *= 0.999;
+
+	/* Sound bursts: rising edge raises sound_detected. */
+	if (!node.sound_state &&
+	    sim_chance(node.rng, sim_constants_t::sound_burst_mean_ms))
+	{
+		node.sound_state = true;
+		node.sound_until_ms = now_ms + 200u + (sim_rand(node.rng) % 1300u);
+		node.sound_level = static_cast<std::int16_t>(
+		    1500u + (sim_rand(node.rng) % 2500u));
+		sim_node_event(fd, central, instance, now_ms,
+			       ble_event_type_t::sound_detected,
+			       node.sound_level, node.last_sound_event_ms,
+			       node.sound_event_armed, stats);
+	}
+	else if (node.sound_state && sim_time_reached(now_ms, node.sound_until_ms))
+	{
+		node.sound_state = false;
+	}
+
+	/* Occasional potentiometer adjustments. */
+	if (sim_chance(node.rng, sim_constants_t::pot_step_mean_ms))
+	{
+		node.pot_raw = static_cast<std::uint16_t>(
+		    sim_rand(node.rng) % (sim_constants_t::adc_max + 1u));
+	}
+
+	/* Rare help button presses toggle the help request. */
+	if (sim_chance(node.rng, sim_constants_t::help_press_mean_ms))
+	{
+		node.help_active = !node.help_active;
+		sim_node_event(fd, central, instance, now_ms,
+			       ble_event_type_t::help_toggled,
+			       node.help_active ? 1 : 0,
+			       node.last_help_event_ms, node.help_event_armed,
+			       stats);
+	}
+
+	if (sim_time_reached(now_ms, node.next_telemetry_ms))
+	{
+		telemetry_packet_t pkt = ble_make_telemetry(ble_node_id_t::sn2);
+		std::uint8_t buf[sizeof(telemetry_packet_t)];
+
+		pkt.flags = ble_telemetry_flag_update(
+		    pkt.flags, ble_telemetry_flag_t::help_active,
+		    node.help_active);
+		pkt.flags = ble_telemetry_flag_update(
+		    pkt.flags, ble_telemetry_flag_t::override_active,
+		    node.override_active);
+		pkt.primary_value = sim_node_temperature(node, now_ms);
+		pkt.secondary_value = node.sound_state ? 1 : 0;
+		pkt.potentiometer_raw = node.pot_raw;
+		pkt.duty_commanded = sim_node_duty(node);
+
+		if (ble_pack_telemetry(buf, sizeof(buf), pkt))
+		{
+			sim_send(fd, central, instance,
+				 sim_characteristic_t::telemetry, buf,
+				 sizeof(buf), stats);
+		}
+		node.next_telemetry_ms += ble_protocol_constants_t::telemetry_period_ms;
+	}
+}
+
+/**
+ * @brief Apply a control write received for one instance.
+ */
+void sim_node_control(sim_node_t &node,
+		      const std::uint8_t *payload,
+		      std::size_t payload_size,
+		      sim_stats_t &stats)
+{
+	control_packet_t ctrl{};
+
+	if (!ble_unpack_control(ctrl, payload, payload_size) ||
+	    (ctrl.target_node_id != static_cast<std::uint8_t>(ble_node_id_t::sn2)))
+	{
+		++stats.controls_rejected;
+	}
+	else
+	{
+		node.override_active = ble_control_flag_is_set(
+		    ctrl.command_flags, ble_control_flag_t::override_enable);
+		node.duty_override = ble_clamp_duty_per_mille(ctrl.duty_override);
+		if (ble_control_flag_is_set(ctrl.command_flags,
+					    ble_control_flag_t::clear_help_request))
+		{
+			node.help_active = false;
+		}
+		++stats.controls_applied;
+	}
+}
+
+/**
+ * @brief Drain all pending control datagrams without blocking.
+ */
+void sim_poll_controls(int fd, std::vector<sim_node_t> &nodes, sim_stats_t &stats)
+{
+	std::uint8_t datagram[sim_link_constants_t::datagram_max];
+	ssize_t got = recv(fd, datagram, sizeof(datagram), MSG_DONTWAIT);
+
+	while (got > 0)
+	{
+		std::uint16_t instance = 0u;
+		sim_characteristic_t characteristic = sim_characteristic_t::control;
+		const std::uint8_t *payload = nullptr;
+		std::size_t payload_size = 0u;
+
+		if (sim_link_unwrap(datagram, static_cast<std::size_t>(got),
+				    instance, characteristic, payload,
+				    payload_size) &&
+		    (characteristic == sim_characteristic_t::control) &&
+		    (instance < nodes.size()))
+		{
+			sim_node_control(nodes[instance], payload, payload_size,
+					 stats);
+		}
+		else
+		{
+			++stats.controls_rejected;
+		}
+
+		got = recv(fd, datagram, sizeof(datagram), MSG_DONTWAIT);
+	}
+}
+
+bool sim_make_address(sockaddr_un &addr, const char *path)
+{
+	bool ok = true;
+
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (std::strlen(path) >= sizeof(addr.sun_path))
+	{
+		ok = false;
+	}
+	else
+	{
+		std::strcpy(addr.sun_path, path);
+		ok = true;
+	}
+
+	return ok;
+}
+
+bool sim_parse_options(int argc, char **argv, sim_options_t &opt)
+{
+	bool ok = true;
+
+	opt.nodes = 1u;
+	opt.bind_path = "/tmp/sn2-sim.sock";
+	opt.central_path = "/tmp/sn2-cn.sock";
+	opt.duration_s = 0.0;
+	opt.speed = 1.0;
+	opt.seed = 1u;
+
+	for (int i = 1; ok && (i < argc); ++i)
+	{
+		const bool has_value = (i + 1) < argc;
+
+		if (has_value && (std::strcmp(argv[i], "--nodes") == 0))
+		{
+			opt.nodes = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if (has_value && (std::strcmp(argv[i], "--bind") == 0))
+		{
+			opt.bind_path = argv[++i];
+		}
+		else if (has_value && (std::strcmp(argv[i], "--central") == 0))
+		{
+			opt.central_path = argv[++i];
+		}
+		else if (has_value && (std::strcmp(argv[i], "--duration") == 0))
+		{
+			opt.duration_s = std::strtod(argv[++i], nullptr);
+		}
+		else if (has_value && (std::strcmp(argv[i], "--speed") == 0))
+		{
+			opt.speed = std::strtod(argv[++i], nullptr);
+		}
+		else if (has_value && (std::strcmp(argv[i], "--seed") == 0))
+		{
+			opt.seed = static_cast<std::uint32_t>(
+			    std::strtoul(argv[++i], nullptr, 10));
+		}
+		else
+		{
+			ok = false;
+		}
+	}
+
+	if ((opt.nodes == 0u) || (opt.nodes > sim_constants_t::nodes_max) ||
+	    (opt.speed < 0.0))
+	{
+		ok = false;
+	}
+
+	return ok;
+}
+
+double sim_wall_ms()
+{
+	timespec ts{};
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (static_cast<double>(ts.tv_sec) * 1000.0) +
+	       (static_cast<double>(ts.tv_nsec) / 1.0e6);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	sim_options_t opt{};
+	sockaddr_un local{};
+	sockaddr_un central{};
+	sim_stats_t stats{};
+	int fd = -1;
+
+	if (!sim_parse_options(argc, argv, opt) ||
+	    !sim_make_address(local, opt.bind_path) ||
+	    !sim_make_address(central, opt.central_path))
+	{
+		std::fprintf(stderr,
+			     "usage: %s [--nodes N] [--bind PATH] [--central PATH]"
+			     " [--duration S] [--speed X] [--seed N]\n",
+			     argv[0]);
+		return 2;
+	}
+
+	fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	unlink(opt.bind_path);
+	if ((fd < 0) ||
+	    (bind(fd, reinterpret_cast<const sockaddr *>(&local),
+		  sizeof(local)) != 0))
+	{
+		std::perror("sn2-sim: socket");
+		return 1;
+	}
+
+	std::signal(SIGINT, sim_on_signal);
+	std::signal(SIGTERM, sim_on_signal);
+
+	std::vector<sim_node_t> nodes(opt.nodes);
+
+	for (std::size_t i = 0u; i < nodes.size(); ++i)
+	{
+		sim_node_init(nodes[i], opt.seed, i);
+	}
+
+	const double duration_ms = opt.duration_s * 1000.0;
+	const double wall_start_ms = sim_wall_ms();
+	std::uint32_t now_ms = 0u;
+	double elapsed_ms = 0.0;
+
+	while ((g_stop == 0) && ((duration_ms <= 0.0) || (elapsed_ms < duration_ms)))
+	{
+		sim_poll_controls(fd, nodes, stats);
+
+		for (std::size_t i = 0u; i < nodes.size(); ++i)
+		{
+			sim_node_step(nodes[i], static_cast<std::uint16_t>(i),
+				      now_ms, fd, central, stats);
+		}
+
+		now_ms += sim_constants_t::tick_ms;
+		elapsed_ms += static_cast<double>(sim_constants_t::tick_ms);
+
+		if (opt.speed > 0.0)
+		{
+			const double target_ms =
+			    wall_start_ms + (elapsed_ms / opt.speed);
+			const double wait_ms = target_ms - sim_wall_ms();
+
+			if (wait_ms > 0.0)
+			{
+				usleep(static_cast<useconds_t>(wait_ms * 1000.0));
+			}
+		}
+	}
+
+	const double wall_s = (sim_wall_ms() - wall_start_ms) / 1000.0;
+
+	std::fprintf(stderr,
+		     "sn2-sim: %zu nodes, %.1f s virtual in %.2f s wall\n"
+		     "  telemetry sent  %llu\n"
+		     "  events sent     %llu\n"
+		     "  send failures   %llu\n"
+		     "  controls ok     %llu\n"
+		     "  controls bad    %llu\n",
+		     nodes.size(), elapsed_ms / 1000.0, wall_s,
+		     static_cast<unsigned long long>(stats.telemetry_sent),
+		     static_cast<unsigned long long>(stats.events_sent),
+		     static_cast<unsigned long long>(stats.send_failures),
+		     static_cast<unsigned long long>(stats.controls_applied),
+		     static_cast<unsigned long long>(stats.controls_rejected));
+
+	close(fd);
+	unlink(opt.bind_path);
+
+	return 0;
+}
@@ -0,0 +1,302 @@
+/**
+ * @file	ble-protocol-bulk.hpp
+ * @brief	Bulk struct-of-arrays decoder for back-to-back telemetry packets
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Gateway-side helper for reprocessing capture logs: decodes a
+ * contiguous buffer of N telemetry_packet_t frames into one array per
+ * field. Eight packets are treated as an 8x8 matrix of 16-bit words
+ * (seven words per packet plus two overlapping bytes of the next one)
+ * and transposed with unpack instructions, so each field comes out as a
+ * contiguous vector. protocol_version and node_id are compared for the
+ * whole batch and reported once at the end.
+ *
+ * The AVX2 path decodes 16 packets per step, SSE2 decodes 8, and a
+ * portable scalar path handles other targets and the tail. The path is
+ * selected at compile time (build with -mavx2 or -march=native to enable
+ * AVX2). This header is host-only tooling and is not needed by the
+ * sensor node firmware.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "ble-protocol.hpp"
+
+/**
+ * @brief Destination columns for a bulk telemetry decode.
+ * @note Each array must hold at least the decoded packet count.
+ */
+struct telemetry_columns_t final
+{
+	std::uint16_t *flags;
+	std::int16_t *primary_value;
+	std::int16_t *secondary_value;
+	std::uint16_t *potentiometer_raw;
+	std::uint16_t *duty_commanded;
+};
+
+/**
+ * @brief First wire word (protocol_version, node_id) expected per packet.
+ */
+static inline constexpr std::uint16_t ble_telemetry_header_word(
+    ble_node_id_t node_id)
+{
+	return static_cast<std::uint16_t>(
+	    static_cast<std::uint16_t>(ble_protocol_version_t::v1) |
+	    static_cast<std::uint16_t>(static_cast<std::uint16_t>(node_id) << 8));
+}
+
+/**
+ * @brief Portable bulk decode of packets [first, count).
+ * @return true if every decoded packet had the expected header.
+ */
+static inline bool ble_unpack_telemetry_bulk_scalar(
+    const telemetry_columns_t &dst,
+    const std::uint8_t *src,
+    std::size_t first,
+    std::size_t count,
+    ble_node_id_t node_id)
+{
+	const std::uint16_t expected = ble_telemetry_header_word(node_id);
+	std::uint16_t mismatch = 0u;
+
+	for (std::size_t i = first; i < count; ++i)
+	{
+		const std::uint8_t *pkt = src + (i * sizeof(telemetry_packet_t));
+		const telemetry_view_t view{pkt};
+
+		mismatch = static_cast<std::uint16_t>(
+		    mismatch | (ble_load_le<std::uint16_t>(pkt) ^ expected));
+		dst.flags[i] = view.flags();
+		dst.primary_value[i] = view.primary_value();
+		dst.secondary_value[i] = view.secondary_value();
+		dst.potentiometer_raw[i] = view.potentiometer_raw();
+		dst.duty_commanded[i] = view.duty_commanded();
+	}
+
+	return mismatch == 0u;
+}
+
+#if defined(__SSE2__)
+
+/**
+ * @brief Transpose an 8x8 matrix of 16-bit words held in r[0..7].
+ */
+static inline void ble_transpose_8x16_sse2(__m128i (&r)[8])
+{
+	const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+	const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+	const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+	const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+	const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+	const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+	const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+	const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+	const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+	const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+	const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+	const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+	const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+	const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+	const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+	const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+	r[0] = _mm_unpacklo_epi64(b0, b4);
+	r[1] = _mm_unpackhi_epi64(b0, b4);
+	r[2] = _mm_unpacklo_epi64(b1, b5);
+	r[3] = _mm_unpackhi_epi64(b1, b5);
+	r[4] = _mm_unpacklo_epi64(b2, b6);
+	r[5] = _mm_unpackhi_epi64(b2, b6);
+	r[6] = _mm_unpacklo_epi64(b3, b7);
+	r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/**
+ * @brief SSE2 bulk decode, 8 packets per step.
+ * @return Number of packets decoded (a multiple of 8); mismatch is
+ *	   accumulated into header_ok.
+ */
+static inline std::size_t ble_unpack_telemetry_bulk_sse2(
+    const telemetry_columns_t &dst,
+    const std::uint8_t *src,
+    std::size_t count,
+    ble_node_id_t node_id,
+    bool &header_ok)
+{
+	const __m128i expected = _mm_set1_epi16(
+	    static_cast<short>(ble_telemetry_header_word(node_id)));
+	__m128i all_equal = _mm_set1_epi16(-1);
+	std::size_t i = 0u;
+
+	/* Each 16-byte load overruns its packet by 2 bytes, so stop one
+	 * packet early and leave the remainder to the scalar tail. */
+	while ((i + 8u) < count)
+	{
+		const std::uint8_t *base = src + (i * sizeof(telemetry_packet_t));
+		__m128i r[8];
+
+		for (std::size_t k = 0u; k < 8u; ++k)
+		{
+			r[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+			    base + (k * sizeof(telemetry_packet_t))));
+		}
+
+		ble_transpose_8x16_sse2(r);
+
+		all_equal = _mm_and_si128(all_equal, _mm_cmpeq_epi16(r[0], expected));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst.flags + i), r[1]);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst.primary_value + i),
+				 r[2]);
+		_mm_storeu_si128(
+		    reinterpret_cast<__m128i *>(dst.secondary_value + i), r[3]);
+		_mm_storeu_si128(
+		    reinterpret_cast<__m128i *>(dst.potentiometer_raw + i), r[4]);
+		_mm_storeu_si128(
+		    reinterpret_cast<__m128i *>(dst.duty_commanded + i), r[5]);
+		i += 8u;
+	}
+
+	header_ok = header_ok && (_mm_movemask_epi8(all_equal) == 0xFFFF);
+
+	return i;
+}
+
+#endif /* __SSE2__ */
+
+#if defined(__AVX2__)
+
+/**
+ * @brief AVX2 bulk decode, 16 packets per step.
+ *
+ * Lane 0 of each register holds packets i..i+7 and lane 1 holds
+ * i+8..i+15, so the in-lane transpose leaves each field as 16
+ * consecutive values ready for a single store.
+ *
+ * @return Number of packets decoded (a multiple of 16); mismatch is
+ *	   accumulated into header_ok.
+ */
+static inline std::size_t ble_unpack_telemetry_bulk_avx2(
+    const telemetry_columns_t &dst,
+    const std::uint8_t *src,
+    std::size_t count,
+    ble_node_id_t node_id,
+    bool &header_ok)
+{
+	const __m256i expected = _mm256_set1_epi16(
+	    static_cast<short>(ble_telemetry_header_word(node_id)));
+	__m256i all_equal = _mm256_set1_epi16(-1);
+	std::size_t i = 0u;
+
+	while ((i + 16u) < count)
+	{
+		const std::uint8_t *base = src + (i * sizeof(telemetry_packet_t));
+		__m256i r[8];
+
+		for (std::size_t k = 0u; k < 8u; ++k)
+		{
+			const __m128i lo = _mm_loadu_si128(
+			    reinterpret_cast<const __m128i *>(
+				base + (k * sizeof(telemetry_packet_t))));
+			const __m128i hi = _mm_loadu_si128(
+			    reinterpret_cast<const __m128i *>(
+				base + ((k + 8u) * sizeof(telemetry_packet_t))));
+
+			r[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo),
+						       hi, 1);
+		}
+
+		const __m256i a0 = _mm256_unpacklo_epi16(r[0], r[1]);
+		const __m256i a1 = _mm256_unpackhi_epi16(r[0], r[1]);
+		const __m256i a2 = _mm256_unpacklo_epi16(r[2], r[3]);
+		const __m256i a3 = _mm256_unpackhi_epi16(r[2], r[3]);
+		const __m256i a4 = _mm256_unpacklo_epi16(r[4], r[5]);
+		const __m256i a5 = _mm256_unpackhi_epi16(r[4], r[5]);
+		const __m256i a6 = _mm256_unpacklo_epi16(r[6], r[7]);
+		const __m256i a7 = _mm256_unpackhi_epi16(r[6], r[7]);
+
+		const __m256i b0 = _mm256_unpacklo_epi32(a0, a2);
+		const __m256i b1 = _mm256_unpackhi_epi32(a0, a2);
+		const __m256i b2 = _mm256_unpacklo_epi32(a1, a3);
+		const __m256i b4 = _mm256_unpacklo_epi32(a4, a6);
+		const __m256i b5 = _mm256_unpackhi_epi32(a4, a6);
+		const __m256i b6 = _mm256_unpacklo_epi32(a5, a7);
+
+		const __m256i header = _mm256_unpacklo_epi64(b0, b4);
+		const __m256i flags = _mm256_unpackhi_epi64(b0, b4);
+		const __m256i primary = _mm256_unpacklo_epi64(b1, b5);
+		const __m256i secondary = _mm256_unpackhi_epi64(b1, b5);
+		const __m256i pot = _mm256_unpacklo_epi64(b2, b6);
+		const __m256i duty = _mm256_unpackhi_epi64(b2, b6);
+
+		all_equal = _mm256_and_si256(all_equal,
+					     _mm256_cmpeq_epi16(header, expected));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst.flags + i),
+				    flags);
+		_mm256_storeu_si256(
+		    reinterpret_cast<__m256i *>(dst.primary_value + i), primary);
+		_mm256_storeu_si256(
+		    reinterpret_cast<__m256i *>(dst.secondary_value + i),
+		    secondary);
+		_mm256_storeu_si256(
+		    reinterpret_cast<__m256i *>(dst.potentiometer_raw + i), pot);
+		_mm256_storeu_si256(
+		    reinterpret_cast<__m256i *>(dst.duty_commanded + i), duty);
+		i += 16u;
+	}
+
+	header_ok = header_ok && (_mm256_movemask_epi8(all_equal) == -1);
+
+	return i;
+}
+
+#endif /* __AVX2__ */
+
+/**
+ * @brief Decode back-to-back telemetry packets into field columns.
+ * @param dst Destination columns (each at least count entries).
+ * @param src Contiguous packets, count * 14 bytes.
+ * @param count Number of packets.
+ * @param node_id Node ID every packet is expected to carry.
+ * @return true if every packet carried protocol v1 and node_id.
+ * @note All columns are written even if validation fails; on false the
+ *	 caller should fall back to per-packet ble_unpack_telemetry() to
+ *	 locate the offending frames.
+ */
+static inline bool ble_unpack_telemetry_bulk(
+    const telemetry_columns_t &dst,
+    const std::uint8_t *src,
+    std::size_t count,
+    ble_node_id_t node_id)
+{
+	bool ok = true;
+	std::size_t done = 0u;
+
+	if ((src == nullptr) && (count != 0u))
+	{
+		ok = false;
+	}
+	else
+	{
+#if defined(__AVX2__)
+		done = ble_unpack_telemetry_bulk_avx2(dst, src, count, node_id, ok);
+#elif defined(__SSE2__)
+		done = ble_unpack_telemetry_bulk_sse2(dst, src, count, node_id, ok);
+#endif
+		ok = ble_unpack_telemetry_bulk_scalar(dst, src, done, count,
+						      node_id) &&
+		     ok;
+	}
+
+	return ok;
+}
@@ -39,6 +39,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <type_traits>
 
 /**
  * @brief BLE protocol UUID definitions.
@@ -54,6 +55,10 @@ struct ble_uuid_t final
 	    "8f9d2a12-6a7b-4c7e-9f7b-2c6a0e1d8a40";
 	static constexpr const char *control =
 	    "8f9d2a13-6a7b-4c7e-9f7b-2c6a0e1d8a40";
+	static constexpr const char *telemetry_batch =
+	    "8f9d2a14-6a7b-4c7e-9f7b-2c6a0e1d8a40";
+	static constexpr const char *telemetry_stream =
+	    "8f9d2a15-6a7b-4c7e-9f7b-2c6a0e1d8a40";
 };
 
 /**
@@ -64,6 +69,16 @@ enum class ble_protocol_version_t : std::uint8_t
 	v1 = 1u
 };
 
+/**
+ * @brief Layout version of the telemetry batch payload.
+ * @note Versioned independently so batching can evolve without
+ *	 bumping ble_protocol_version_t for the single-sample packets.
+ */
+enum class ble_telemetry_batch_format_t : std::uint8_t
+{
+	v1 = 1u
+};
+
 /**
  * @brief Logical node identifiers used on the BLE link.
  */
@@ -116,6 +131,9 @@ struct ble_protocol_constants_t final
 
 	static constexpr std::uint32_t telemetry_period_ms = 1000u;
 	static constexpr std::uint32_t event_lockout_ms = 5000u;
+
+	/* Largest notification payload on Photon 2 (247-byte ATT MTU). */
+	static constexpr std::size_t notify_payload_max = 244u;
 };
 
 /*
@@ -178,6 +196,36 @@ struct control_packet_t final
 	std::uint16_t reserved;
 };
 
+/**
+ * @brief Header of a telemetry batch notification.
+ * @note Followed by sample_count telemetry_batch_sample_t records.
+ *	 Sent on the telemetry_batch characteristic.
+ */
+struct telemetry_batch_header_t final
+{
+	std::uint8_t protocol_version;
+	std::uint8_t node_id;
+	std::uint8_t batch_format;
+	std::uint8_t sample_count;
+	std::uint32_t base_timestamp_ms;
+};
+
+/**
+ * @brief One sample inside a telemetry batch.
+ *
+ * Field meaning matches telemetry_packet_t. delta_ms is the sample time
+ * relative to telemetry_batch_header_t::base_timestamp_ms.
+ */
+struct telemetry_batch_sample_t final
+{
+	std::uint16_t delta_ms;
+	std::uint16_t flags;
+	std::int16_t primary_value;
+	std::int16_t secondary_value;
+	std::uint16_t potentiometer_raw;
+	std::uint16_t duty_commanded;
+};
+
 /* Restore packing rules. */
 #pragma pack(pop)
 
@@ -195,6 +243,10 @@ static_assert(sizeof(event_packet_t) == 7u,
 	      "event_packet_t size changed");
 static_assert(sizeof(control_packet_t) == 8u,
 	      "control_packet_t size changed");
+static_assert(sizeof(telemetry_batch_header_t) == 8u,
+	      "telemetry_batch_header_t size changed");
+static_assert(sizeof(telemetry_batch_sample_t) == 12u,
+	      "telemetry_batch_sample_t size changed");
 
 /**
  * @brief Convert a telemetry flag to its underlying bit mask.
@@ -291,216 +343,1951 @@ static inline constexpr std::uint16_t ble_clamp_duty_per_mille(
 	return clamped;
 }
 
+/*
+ * Little-endian field access.
+ *
+ * ble_load_le() and ble_store_le() read and write wire fields of any
+ * integer width one byte at a time in explicit little-endian order. They
+ * never form a pointer to a packed member, so they are safe on any buffer
+ * alignment, and compilers fold them to a single (unaligned-capable) load
+ * or store on little-endian targets such as the Cortex-M33.
+ */
+
 /**
- * @brief Validate protocol version on a received packet buffer.
- * @param expected Expected protocol version.
- * @param buffer Source buffer.
- * @param buffer_size Buffer size in bytes.
- * @return true if valid, otherwise false.
+ * @brief Report whether the compilation target is little-endian.
+ * @return true on little-endian targets, otherwise false.
+ * @note Unknown targets report false and take the portable path.
  */
-static inline bool ble_validate_protocol_version(
-    ble_protocol_version_t expected,
-    const std::uint8_t *buffer,
-    std::size_t buffer_size)
+static inline constexpr bool ble_host_is_little_endian()
 {
-	bool valid = true;
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+	return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#else
+	return false;
+#endif
+}
 
-	if (buffer == nullptr)
-	{
-		valid = false;
-	}
-	else if (buffer_size < 1u)
-	{
-		valid = false;
-	}
-	else if (buffer[0] != static_cast<std::uint8_t>(expected))
+/**
+ * @brief Store an integer of any width in little-endian order.
+ * @param dst Destination bytes (at least sizeof(T)).
+ * @param value Value to store.
+ */
+template <typename T>
+static inline constexpr void ble_store_le(std::uint8_t *dst, T value)
+{
+	using raw_t = typename std::make_unsigned<T>::type;
+	const raw_t raw = static_cast<raw_t>(value);
+
+	for (std::size_t i = 0u; i < sizeof(T); ++i)
 	{
-		valid = false;
+		dst[i] = static_cast<std::uint8_t>((raw >> (8u * i)) & 0xFFu);
 	}
-	else
+}
+
+/**
+ * @brief Load an integer of any width in little-endian order.
+ * @param src Source bytes (at least sizeof(T)).
+ * @return Decoded value.
+ */
+template <typename T>
+static inline constexpr T ble_load_le(const std::uint8_t *src)
+{
+	using raw_t = typename std::make_unsigned<T>::type;
+	raw_t raw = 0u;
+
+	for (std::size_t i = 0u; i < sizeof(T); ++i)
 	{
-		valid = true;
+		raw = static_cast<raw_t>(
+		    raw | static_cast<raw_t>(static_cast<raw_t>(src[i])
+					     << (8u * i)));
 	}
 
-	return valid;
+	return static_cast<T>(raw);
 }
 
+/*
+ * Zero-copy packet views.
+ *
+ * A view wraps a raw BLE buffer and decodes individual fields in place,
+ * so the control node can inspect notifications without copying them
+ * into packed structs first. Field offsets are taken from the packed
+ * structs above, which keeps views and structs in lock-step.
+ *
+ * Views do not check the buffer length; obtain them through
+ * ble_view_telemetry(), ble_view_event() or ble_view_control(), or
+ * guarantee wire_size bytes yourself.
+ */
+
 /**
- * @brief Serialise a telemetry packet into a byte buffer.
- * @param dst Destination buffer.
- * @param dst_size Destination buffer size in bytes.
- * @param src Packet to serialise.
- * @return true if written, otherwise false.
+ * @brief Read-only view of a telemetry packet in a byte buffer.
  */
-static inline bool ble_pack_telemetry(
-    std::uint8_t *dst,
-    std::size_t dst_size,
-    const telemetry_packet_t &src)
+struct telemetry_view_t final
 {
-	bool ok = true;
+	static constexpr std::size_t wire_size = sizeof(telemetry_packet_t);
 
-	if (dst == nullptr)
+	const std::uint8_t *bytes;
+
+	constexpr std::uint8_t protocol_version() const
 	{
-		ok = false;
+		return bytes[offsetof(telemetry_packet_t, protocol_version)];
 	}
-	else if (dst_size < sizeof(telemetry_packet_t))
+
+	constexpr std::uint8_t node_id() const
 	{
-		ok = false;
+		return bytes[offsetof(telemetry_packet_t, node_id)];
 	}
-	else if (src.protocol_version !=
-		 static_cast<std::uint8_t>(ble_protocol_version_t::v1))
+
+	constexpr std::uint16_t flags() const
 	{
-		ok = false;
+		return ble_load_le<std::uint16_t>(bytes + offsetof(telemetry_packet_t, flags));
 	}
-	else
+
+	constexpr std::int16_t primary_value() const
 	{
-		std::memcpy(dst, &src, sizeof(telemetry_packet_t));
-		ok = true;
+		return ble_load_le<std::int16_t>(
+		    bytes + offsetof(telemetry_packet_t, primary_value));
 	}
 
-	return ok;
-}
+	constexpr std::int16_t secondary_value() const
+	{
+		return ble_load_le<std::int16_t>(
+		    bytes + offsetof(telemetry_packet_t, secondary_value));
+	}
+
+	constexpr std::uint16_t potentiometer_raw() const
+	{
+		return ble_load_le<std::uint16_t>(
+		    bytes + offsetof(telemetry_packet_t, potentiometer_raw));
+	}
+
+	constexpr std::uint16_t duty_commanded() const
+	{
+		return ble_load_le<std::uint16_t>(
+		    bytes + offsetof(telemetry_packet_t, duty_commanded));
+	}
+
+	constexpr std::uint16_t reserved() const
+	{
+		return ble_load_le<std::uint16_t>(
+		    bytes + offsetof(telemetry_packet_t, reserved));
+	}
+
+	constexpr telemetry_packet_t to_packet() const
+	{
+		telemetry_packet_t pkt{};
+
+		pkt.protocol_version = protocol_version();
+		pkt.node_id = node_id();
+		pkt.flags = flags();
+		pkt.primary_value = primary_value();
+		pkt.secondary_value = secondary_value();
+		pkt.potentiometer_raw = potentiometer_raw();
+		pkt.duty_commanded = duty_commanded();
+		pkt.reserved = reserved();
+
+		return pkt;
+	}
+};
 
 /**
- * @brief Serialise an event packet into a byte buffer.
- * @param dst Destination buffer.
- * @param dst_size Destination buffer size in bytes.
- * @param src Packet to serialise.
- * @return true if written, otherwise false.
+ * @brief Writable view of a telemetry packet in a byte buffer.
  */
-static inline bool ble_pack_event(
-    std::uint8_t *dst,
-    std::size_t dst_size,
-    const event_packet_t &src)
+struct telemetry_writer_t final
 {
-	bool ok = true;
+	static constexpr std::size_t wire_size = sizeof(telemetry_packet_t);
 
-	if (dst == nullptr)
+	std::uint8_t *bytes;
+
+	constexpr telemetry_view_t view() const
 	{
-		ok = false;
+		return telemetry_view_t{bytes};
 	}
-	else if (dst_size < sizeof(event_packet_t))
+
+	constexpr void set_protocol_version(std::uint8_t value) const
 	{
-		ok = false;
+		bytes[offsetof(telemetry_packet_t, protocol_version)] = value;
 	}
-	else if (src.protocol_version !=
-		 static_cast<std::uint8_t>(ble_protocol_version_t::v1))
+
+	constexpr void set_node_id(std::uint8_t value) const
 	{
-		ok = false;
+		bytes[offsetof(telemetry_packet_t, node_id)] = value;
 	}
-	else
+
+	constexpr void set_flags(std::uint16_t value) const
 	{
-		std::memcpy(dst, &src, sizeof(event_packet_t));
-		ok = true;
+		ble_store_le<std::uint16_t>(bytes + offsetof(telemetry_packet_t, flags),
+				 value);
 	}
 
-	return ok;
-}
+	constexpr void set_primary_value(std::int16_t value) const
+	{
+		ble_store_le<std::int16_t>(
+		    bytes + offsetof(telemetry_packet_t, primary_value), value);
+	}
 
-/**
- * @brief Deserialise a control packet from a byte buffer.
- * @param dst Destination packet.
- * @param src Source buffer.
- * @param src_size Source buffer size in bytes.
- * @return true if parsed, otherwise false.
- */
-static inline bool ble_unpack_control(
-    control_packet_t &dst,
-    const std::uint8_t *src,
-    std::size_t src_size)
-{
-	bool ok = true;
+	constexpr void set_secondary_value(std::int16_t value) const
+	{
+		ble_store_le<std::int16_t>(
+		    bytes + offsetof(telemetry_packet_t, secondary_value), value);
+	}
 
-	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
-					   src, src_size))
+	constexpr void set_potentiometer_raw(std::uint16_t value) const
 	{
-		ok = false;
+		ble_store_le<std::uint16_t>(
+		    bytes + offsetof(telemetry_packet_t, potentiometer_raw), value);
 	}
-	else if (src_size < sizeof(control_packet_t))
+
+	constexpr void set_duty_commanded(std::uint16_t value) const
 	{
-		ok = false;
+		ble_store_le<std::uint16_t>(
+		    bytes + offsetof(telemetry_packet_t, duty_commanded), value);
 	}
-	else
+
+	constexpr void set_reserved(std::uint16_t value) const
 	{
-		std::memcpy(&dst, src, sizeof(control_packet_t));
-		ok = true;
+		ble_store_le<std::uint16_t>(bytes + offsetof(telemetry_packet_t, reserved),
+				 value);
 	}
 
-	return ok;
-}
+	constexpr void assign(const telemetry_packet_t &src) const
+	{
+		set_protocol_version(src.protocol_version);
+		set_node_id(src.node_id);
+		set_flags(src.flags);
+		set_primary_value(src.primary_value);
+		set_secondary_value(src.secondary_value);
+		set_potentiometer_raw(src.potentiometer_raw);
+		set_duty_commanded(src.duty_commanded);
+		set_reserved(src.reserved);
+	}
+};
 
 /**
- * @brief Build a telemetry packet with required defaults.
- * @param node_id Node ID to embed.
- * @return Initialised packet.
+ * @brief Read-only view of an event packet in a byte buffer.
  */
-static inline telemetry_packet_t ble_make_telemetry(
-    ble_node_id_t node_id)
+struct event_view_t final
 {
-	telemetry_packet_t pkt{};
+	static constexpr std::size_t wire_size = sizeof(event_packet_t);
 
-	pkt.protocol_version =
-	    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
-	pkt.node_id = static_cast<std::uint8_t>(node_id);
-	pkt.flags = 0u;
-	pkt.primary_value = 0;
-	pkt.secondary_value = 0;
-	pkt.potentiometer_raw = 0u;
-	pkt.duty_commanded = 0u;
-	pkt.reserved = 0u;
+	const std::uint8_t *bytes;
 
-	return pkt;
-}
+	constexpr std::uint8_t protocol_version() const
+	{
+		return bytes[offsetof(event_packet_t, protocol_version)];
+	}
+
+	constexpr std::uint8_t node_id() const
+	{
+		return bytes[offsetof(event_packet_t, node_id)];
+	}
+
+	constexpr std::uint8_t event_type() const
+	{
+		return bytes[offsetof(event_packet_t, event_type)];
+	}
+
+	constexpr std::int16_t event_value() const
+	{
+		return ble_load_le<std::int16_t>(
+		    bytes + offsetof(event_packet_t, event_value));
+	}
+
+	constexpr std::uint16_t timestamp_ms_mod() const
+	{
+		return ble_load_le<std::uint16_t>(
+		    bytes + offsetof(event_packet_t, timestamp_ms_mod));
+	}
+
+	constexpr event_packet_t to_packet() const
+	{
+		event_packet_t pkt{};
+
+		pkt.protocol_version = protocol_version();
+		pkt.node_id = node_id();
+		pkt.event_type = event_type();
+		pkt.event_value = event_value();
+		pkt.timestamp_ms_mod = timestamp_ms_mod();
+
+		return pkt;
+	}
+};
 
 /**
- * @brief Build an event packet with required defaults.
- * @param node_id Node ID to embed.
- * @param type Event type.
- * @param value Event value.
- * @param timestamp_ms_mod Timestamp modulo 65536.
- * @return Initialised packet.
+ * @brief Writable view of an event packet in a byte buffer.
  */
-static inline event_packet_t ble_make_event(
-    ble_node_id_t node_id,
-    ble_event_type_t type,
-    std::int16_t value,
-    std::uint16_t timestamp_ms_mod)
+struct event_writer_t final
 {
-	event_packet_t pkt{};
+	static constexpr std::size_t wire_size = sizeof(event_packet_t);
 
-	pkt.protocol_version =
-	    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
-	pkt.node_id = static_cast<std::uint8_t>(node_id);
-	pkt.event_type = static_cast<std::uint8_t>(type);
-	pkt.event_value = value;
-	pkt.timestamp_ms_mod = timestamp_ms_mod;
+	std::uint8_t *bytes;
 
-	return pkt;
-}
+	constexpr event_view_t view() const
+	{
+		return event_view_t{bytes};
+	}
+
+	constexpr void set_protocol_version(std::uint8_t value) const
+	{
+		bytes[offsetof(event_packet_t, protocol_version)] = value;
+	}
+
+	constexpr void set_node_id(std::uint8_t value) const
+	{
+		bytes[offsetof(event_packet_t, node_id)] = value;
+	}
+
+	constexpr void set_event_type(std::uint8_t value) const
+	{
+		bytes[offsetof(event_packet_t, event_type)] = value;
+	}
+
+	constexpr void set_event_value(std::int16_t value) const
+	{
+		ble_store_le<std::int16_t>(bytes + offsetof(event_packet_t, event_value),
+				 value);
+	}
+
+	constexpr void set_timestamp_ms_mod(std::uint16_t value) const
+	{
+		ble_store_le<std::uint16_t>(
+		    bytes + offsetof(event_packet_t, timestamp_ms_mod), value);
+	}
+
+	constexpr void assign(const event_packet_t &src) const
+	{
+		set_protocol_version(src.protocol_version);
+		set_node_id(src.node_id);
+		set_event_type(src.event_type);
+		set_event_value(src.event_value);
+		set_timestamp_ms_mod(src.timestamp_ms_mod);
+	}
+};
 
 /**
- * @brief Build a control packet with required defaults.
- * @param target Target node ID.
- * @param flags Command flags.
- * @param duty_override Duty in per-mille 0..1000.
- * @return Initialised packet.
+ * @brief Read-only view of a control packet in a byte buffer.
  */
-static inline control_packet_t ble_make_control(
-    ble_node_id_t target,
-    std::uint16_t flags,
-    std::uint16_t duty_override)
+struct control_view_t final
 {
-	control_packet_t pkt{};
-
-	pkt.protocol_version =
-	    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
-	pkt.target_node_id = static_cast<std::uint8_t>(target);
-	pkt.command_flags = flags;
-	pkt.duty_override = ble_clamp_duty_per_mille(duty_override);
-	pkt.reserved = 0u;
+	static constexpr std::size_t wire_size = sizeof(control_packet_t);
 
-	return pkt;
-}
+	const std::uint8_t *bytes;
+
+	constexpr std::uint8_t protocol_version() const
+	{
+		return bytes[offsetof(control_packet_t, protocol_version)];
+	}
+
+	constexpr std::uint8_t target_node_id() const
+	{
+		return bytes[offsetof(control_packet_t, target_node_id)];
+	}
+
+	constexpr std::uint16_t command_flags() const
+	{
+		return ble_load_le<std::uint16_t>(
+		    bytes + offsetof(control_packet_t, command_flags));
+	}
+
+	constexpr std::uint16_t duty_override() const
+	{
+		return ble_load_le<std::uint16_t>(
+		    bytes + offsetof(control_packet_t, duty_override));
+	}
+
+	constexpr std::uint16_t reserved() const
+	{
+		return ble_load_le<std::uint16_t>(bytes + offsetof(control_packet_t, reserved));
+	}
+
+	constexpr control_packet_t to_packet() const
+	{
+		control_packet_t pkt{};
+
+		pkt.protocol_version = protocol_version();
+		pkt.target_node_id = target_node_id();
+		pkt.command_flags = command_flags();
+		pkt.duty_override = duty_override();
+		pkt.reserved = reserved();
+
+		return pkt;
+	}
+};
+
+/**
+ * @brief Writable view of a control packet in a byte buffer.
+ */
+struct control_writer_t final
+{
+	static constexpr std::size_t wire_size = sizeof(control_packet_t);
+
+	std::uint8_t *bytes;
+
+	constexpr control_view_t view() const
+	{
+		return control_view_t{bytes};
+	}
+
+	constexpr void set_protocol_version(std::uint8_t value) const
+	{
+		bytes[offsetof(control_packet_t, protocol_version)] = value;
+	}
+
+	constexpr void set_target_node_id(std::uint8_t value) const
+	{
+		bytes[offsetof(control_packet_t, target_node_id)] = value;
+	}
+
+	constexpr void set_command_flags(std::uint16_t value) const
+	{
+		ble_store_le<std::uint16_t>(
+		    bytes + offsetof(control_packet_t, command_flags), value);
+	}
+
+	constexpr void set_duty_override(std::uint16_t value) const
+	{
+		ble_store_le<std::uint16_t>(
+		    bytes + offsetof(control_packet_t, duty_override), value);
+	}
+
+	constexpr void set_reserved(std::uint16_t value) const
+	{
+		ble_store_le<std::uint16_t>(bytes + offsetof(control_packet_t, reserved),
+				 value);
+	}
+
+	constexpr void assign(const control_packet_t &src) const
+	{
+		set_protocol_version(src.protocol_version);
+		set_target_node_id(src.target_node_id);
+		set_command_flags(src.command_flags);
+		set_duty_override(src.duty_override);
+		set_reserved(src.reserved);
+	}
+};
+
+/*
+ * Endian-portable wire codec.
+ *
+ * Every packet is described by exactly one field table: an ordered list
+ * of ble_wire_field_t entries naming the struct member and its wire
+ * offset. ble_wire_codec_t expands the table at compile time into a
+ * field-by-field little-endian encoder/decoder. On little-endian hosts
+ * the packed struct already matches the wire, so at run time the codec
+ * collapses to a single memcpy; on any other host, and in constant
+ * expressions, each field is byte-swapped through the table. The same code therefore runs unmodified on the node, the
+ * control node and host-side tooling.
+ */
+
+/**
+ * @brief Report whether the codec may copy a packed struct as-is.
+ * @return true on little-endian targets outside constant evaluation.
+ * @note Compilers without __builtin_is_constant_evaluated() always take
+ *	 the field-by-field path, which is correct but slower.
+ */
+static inline constexpr bool ble_wire_can_memcpy()
+{
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+	return ble_host_is_little_endian() && !__builtin_is_constant_evaluated();
+#else
+	return false;
+#endif
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief One entry of a packet field table.
+ * @tparam Packet Packed wire struct.
+ * @tparam Field Member type.
+ * @tparam Member Pointer to the member.
+ * @tparam Offset Byte offset of the member on the wire.
+ */
+template <typename Packet, typename Field, Field Packet::*Member,
+	  std::size_t Offset>
+struct ble_wire_field_t final
+{
+	static constexpr std::size_t offset = Offset;
+	static constexpr std::size_t size = sizeof(Field);
+
+	static constexpr void encode(std::uint8_t *dst, const Packet &src)
+	{
+		ble_store_le<Field>(dst + Offset, src.*Member);
+	}
+
+	static constexpr void decode(Packet &dst, const std::uint8_t *src)
+	{
+		dst.*Member = ble_load_le<Field>(src + Offset);
+	}
+};
+
+/**
+ * @brief Encoder/decoder generated from a packet field table.
+ * @tparam Packet Packed wire struct.
+ * @tparam Fields Field table, in wire order.
+ */
+template <typename Packet, typename... Fields>
+struct ble_wire_codec_t final
+{
+	static constexpr std::size_t wire_size = sizeof(Packet);
+
+	/**
+	 * @brief Check the table covers the struct densely and in order.
+	 * @return true if every byte belongs to exactly one field.
+	 */
+	static constexpr bool layout_is_dense()
+	{
+		std::size_t next = 0u;
+		bool ok = true;
+
+		((ok = ok && (Fields::offset == next), next += Fields::size),
+		 ...);
+
+		return ok && (next == wire_size);
+	}
+
+	/**
+	 * @brief Encode field by field (usable in constant expressions).
+	 */
+	static constexpr void encode_fields(std::uint8_t *dst,
+					    const Packet &src)
+	{
+		(Fields::encode(dst, src), ...);
+	}
+
+	/**
+	 * @brief Decode field by field (usable in constant expressions).
+	 */
+	static constexpr void decode_fields(Packet &dst,
+					    const std::uint8_t *src)
+	{
+		(Fields::decode(dst, src), ...);
+	}
+
+	/**
+	 * @brief Encode a packet into wire_size bytes.
+	 */
+	static constexpr void encode(std::uint8_t *dst, const Packet &src)
+	{
+		if (ble_wire_can_memcpy())
+		{
+			std::memcpy(dst, &src, wire_size);
+		}
+		else
+		{
+			encode_fields(dst, src);
+		}
+	}
+
+	/**
+	 * @brief Decode a packet from wire_size bytes.
+	 */
+	static constexpr void decode(Packet &dst, const std::uint8_t *src)
+	{
+		if (ble_wire_can_memcpy())
+		{
+			std::memcpy(&dst, src, wire_size);
+		}
+		else
+		{
+			decode_fields(dst, src);
+		}
+	}
+};
+
+/**
+ * @brief Telemetry packet field table and codec.
+ */
+using ble_telemetry_codec_t = ble_wire_codec_t<
+    telemetry_packet_t,
+    ble_wire_field_t<telemetry_packet_t, std::uint8_t,
+		     &telemetry_packet_t::protocol_version,
+		     offsetof(telemetry_packet_t, protocol_version)>,
+    ble_wire_field_t<telemetry_packet_t, std::uint8_t,
+		     &telemetry_packet_t::node_id,
+		     offsetof(telemetry_packet_t, node_id)>,
+    ble_wire_field_t<telemetry_packet_t, std::uint16_t,
+		     &telemetry_packet_t::flags,
+		     offsetof(telemetry_packet_t, flags)>,
+    ble_wire_field_t<telemetry_packet_t, std::int16_t,
+		     &telemetry_packet_t::primary_value,
+		     offsetof(telemetry_packet_t, primary_value)>,
+    ble_wire_field_t<telemetry_packet_t, std::int16_t,
+		     &telemetry_packet_t::secondary_value,
+		     offsetof(telemetry_packet_t, secondary_value)>,
+    ble_wire_field_t<telemetry_packet_t, std::uint16_t,
+		     &telemetry_packet_t::potentiometer_raw,
+		     offsetof(telemetry_packet_t, potentiometer_raw)>,
+    ble_wire_field_t<telemetry_packet_t, std::uint16_t,
+		     &telemetry_packet_t::duty_commanded,
+		     offsetof(telemetry_packet_t, duty_commanded)>,
+    ble_wire_field_t<telemetry_packet_t, std::uint16_t,
+		     &telemetry_packet_t::reserved,
+		     offsetof(telemetry_packet_t, reserved)>>;
+
+/**
+ * @brief Event packet field table and codec.
+ */
+using ble_event_codec_t = ble_wire_codec_t<
+    event_packet_t,
+    ble_wire_field_t<event_packet_t, std::uint8_t,
+		     &event_packet_t::protocol_version,
+		     offsetof(event_packet_t, protocol_version)>,
+    ble_wire_field_t<event_packet_t, std::uint8_t,
+		     &event_packet_t::node_id,
+		     offsetof(event_packet_t, node_id)>,
+    ble_wire_field_t<event_packet_t, std::uint8_t,
+		     &event_packet_t::event_type,
+		     offsetof(event_packet_t, event_type)>,
+    ble_wire_field_t<event_packet_t, std::int16_t,
+		     &event_packet_t::event_value,
+		     offsetof(event_packet_t, event_value)>,
+    ble_wire_field_t<event_packet_t, std::uint16_t,
+		     &event_packet_t::timestamp_ms_mod,
+		     offsetof(event_packet_t, timestamp_ms_mod)>>;
+
+/**
+ * @brief Control packet field table and codec.
+ */
+using ble_control_codec_t = ble_wire_codec_t<
+    control_packet_t,
+    ble_wire_field_t<control_packet_t, std::uint8_t,
+		     &control_packet_t::protocol_version,
+		     offsetof(control_packet_t, protocol_version)>,
+    ble_wire_field_t<control_packet_t, std::uint8_t,
+		     &control_packet_t::target_node_id,
+		     offsetof(control_packet_t, target_node_id)>,
+    ble_wire_field_t<control_packet_t, std::uint16_t,
+		     &control_packet_t::command_flags,
+		     offsetof(control_packet_t, command_flags)>,
+    ble_wire_field_t<control_packet_t, std::uint16_t,
+		     &control_packet_t::duty_override,
+		     offsetof(control_packet_t, duty_override)>,
+    ble_wire_field_t<control_packet_t, std::uint16_t,
+		     &control_packet_t::reserved,
+		     offsetof(control_packet_t, reserved)>>;
+
+/**
+ * @brief Telemetry batch header field table and codec.
+ */
+using ble_telemetry_batch_header_codec_t = ble_wire_codec_t<
+    telemetry_batch_header_t,
+    ble_wire_field_t<telemetry_batch_header_t, std::uint8_t,
+		     &telemetry_batch_header_t::protocol_version,
+		     offsetof(telemetry_batch_header_t, protocol_version)>,
+    ble_wire_field_t<telemetry_batch_header_t, std::uint8_t,
+		     &telemetry_batch_header_t::node_id,
+		     offsetof(telemetry_batch_header_t, node_id)>,
+    ble_wire_field_t<telemetry_batch_header_t, std::uint8_t,
+		     &telemetry_batch_header_t::batch_format,
+		     offsetof(telemetry_batch_header_t, batch_format)>,
+    ble_wire_field_t<telemetry_batch_header_t, std::uint8_t,
+		     &telemetry_batch_header_t::sample_count,
+		     offsetof(telemetry_batch_header_t, sample_count)>,
+    ble_wire_field_t<telemetry_batch_header_t, std::uint32_t,
+		     &telemetry_batch_header_t::base_timestamp_ms,
+		     offsetof(telemetry_batch_header_t, base_timestamp_ms)>>;
+
+/**
+ * @brief Telemetry batch sample field table and codec.
+ */
+using ble_telemetry_batch_sample_codec_t = ble_wire_codec_t<
+    telemetry_batch_sample_t,
+    ble_wire_field_t<telemetry_batch_sample_t, std::uint16_t,
+		     &telemetry_batch_sample_t::delta_ms,
+		     offsetof(telemetry_batch_sample_t, delta_ms)>,
+    ble_wire_field_t<telemetry_batch_sample_t, std::uint16_t,
+		     &telemetry_batch_sample_t::flags,
+		     offsetof(telemetry_batch_sample_t, flags)>,
+    ble_wire_field_t<telemetry_batch_sample_t, std::int16_t,
+		     &telemetry_batch_sample_t::primary_value,
+		     offsetof(telemetry_batch_sample_t, primary_value)>,
+    ble_wire_field_t<telemetry_batch_sample_t, std::int16_t,
+		     &telemetry_batch_sample_t::secondary_value,
+		     offsetof(telemetry_batch_sample_t, secondary_value)>,
+    ble_wire_field_t<telemetry_batch_sample_t, std::uint16_t,
+		     &telemetry_batch_sample_t::potentiometer_raw,
+		     offsetof(telemetry_batch_sample_t, potentiometer_raw)>,
+    ble_wire_field_t<telemetry_batch_sample_t, std::uint16_t,
+		     &telemetry_batch_sample_t::duty_commanded,
+		     offsetof(telemetry_batch_sample_t, duty_commanded)>>;
+
+/*
+ * Field tables must cover every byte of their packet exactly once, so a
+ * member added to a struct without a table entry fails to compile.
+ */
+static_assert(ble_telemetry_codec_t::layout_is_dense(),
+	      "telemetry field table does not match telemetry_packet_t");
+static_assert(ble_event_codec_t::layout_is_dense(),
+	      "event field table does not match event_packet_t");
+static_assert(ble_control_codec_t::layout_is_dense(),
+	      "control field table does not match control_packet_t");
+static_assert(ble_telemetry_batch_header_codec_t::layout_is_dense(),
+	      "batch header field table does not match its struct");
+static_assert(ble_telemetry_batch_sample_codec_t::layout_is_dense(),
+	      "batch sample field table does not match its struct");
+
+/**
+ * @brief Validate protocol version on a received packet buffer.
+ * @param expected Expected protocol version.
+ * @param buffer Source buffer.
+ * @param buffer_size Buffer size in bytes.
+ * @return true if valid, otherwise false.
+ */
+static inline constexpr bool ble_validate_protocol_version(
+    ble_protocol_version_t expected,
+    const std::uint8_t *buffer,
+    std::size_t buffer_size)
+{
+	bool valid = true;
+
+	if (buffer == nullptr)
+	{
+		valid = false;
+	}
+	else if (buffer_size < 1u)
+	{
+		valid = false;
+	}
+	else if (buffer[0] != static_cast<std::uint8_t>(expected))
+	{
+		valid = false;
+	}
+	else
+	{
+		valid = true;
+	}
+
+	return valid;
+}
+
+/**
+ * @brief Serialise a telemetry packet into a byte buffer.
+ * @param dst Destination buffer.
+ * @param dst_size Destination buffer size in bytes.
+ * @param src Packet to serialise.
+ * @return true if written, otherwise false.
+ */
+static inline constexpr bool ble_pack_telemetry(
+    std::uint8_t *dst,
+    std::size_t dst_size,
+    const telemetry_packet_t &src)
+{
+	bool ok = true;
+
+	if (dst == nullptr)
+	{
+		ok = false;
+	}
+	else if (dst_size < sizeof(telemetry_packet_t))
+	{
+		ok = false;
+	}
+	else if (src.protocol_version !=
+		 static_cast<std::uint8_t>(ble_protocol_version_t::v1))
+	{
+		ok = false;
+	}
+	else
+	{
+		ble_telemetry_codec_t::encode(dst, src);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Serialise an event packet into a byte buffer.
+ * @param dst Destination buffer.
+ * @param dst_size Destination buffer size in bytes.
+ * @param src Packet to serialise.
+ * @return true if written, otherwise false.
+ */
+static inline constexpr bool ble_pack_event(
+    std::uint8_t *dst,
+    std::size_t dst_size,
+    const event_packet_t &src)
+{
+	bool ok = true;
+
+	if (dst == nullptr)
+	{
+		ok = false;
+	}
+	else if (dst_size < sizeof(event_packet_t))
+	{
+		ok = false;
+	}
+	else if (src.protocol_version !=
+		 static_cast<std::uint8_t>(ble_protocol_version_t::v1))
+	{
+		ok = false;
+	}
+	else
+	{
+		ble_event_codec_t::encode(dst, src);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Deserialise a control packet from a byte buffer.
+ * @param dst Destination packet.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @return true if parsed, otherwise false.
+ */
+static inline constexpr bool ble_unpack_control(
+    control_packet_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size)
+{
+	bool ok = true;
+
+	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
+					   src, src_size))
+	{
+		ok = false;
+	}
+	else if (src_size < sizeof(control_packet_t))
+	{
+		ok = false;
+	}
+	else
+	{
+		ble_control_codec_t::decode(dst, src);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Deserialise a telemetry packet from a byte buffer.
+ * @param dst Destination packet.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @return true if parsed, otherwise false.
+ */
+static inline constexpr bool ble_unpack_telemetry(
+    telemetry_packet_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size)
+{
+	bool ok = true;
+
+	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
+					   src, src_size))
+	{
+		ok = false;
+	}
+	else if (src_size < sizeof(telemetry_packet_t))
+	{
+		ok = false;
+	}
+	else
+	{
+		ble_telemetry_codec_t::decode(dst, src);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Deserialise an event packet from a byte buffer.
+ * @param dst Destination packet.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @return true if parsed, otherwise false.
+ */
+static inline constexpr bool ble_unpack_event(
+    event_packet_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size)
+{
+	bool ok = true;
+
+	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
+					   src, src_size))
+	{
+		ok = false;
+	}
+	else if (src_size < sizeof(event_packet_t))
+	{
+		ok = false;
+	}
+	else
+	{
+		ble_event_codec_t::decode(dst, src);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Serialise a control packet into a byte buffer.
+ * @param dst Destination buffer.
+ * @param dst_size Destination buffer size in bytes.
+ * @param src Packet to serialise.
+ * @return true if written, otherwise false.
+ */
+static inline constexpr bool ble_pack_control(
+    std::uint8_t *dst,
+    std::size_t dst_size,
+    const control_packet_t &src)
+{
+	bool ok = true;
+
+	if (dst == nullptr)
+	{
+		ok = false;
+	}
+	else if (dst_size < sizeof(control_packet_t))
+	{
+		ok = false;
+	}
+	else if (src.protocol_version !=
+		 static_cast<std::uint8_t>(ble_protocol_version_t::v1))
+	{
+		ok = false;
+	}
+	else
+	{
+		ble_control_codec_t::encode(dst, src);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Obtain a zero-copy view of a received telemetry buffer.
+ * @param dst Destination view.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @return true if the buffer holds a valid telemetry packet, otherwise false.
+ */
+static inline constexpr bool ble_view_telemetry(
+    telemetry_view_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size)
+{
+	bool ok = true;
+
+	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
+					   src, src_size))
+	{
+		ok = false;
+	}
+	else if (src_size < telemetry_view_t::wire_size)
+	{
+		ok = false;
+	}
+	else
+	{
+		dst = telemetry_view_t{src};
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Obtain a zero-copy view of a received event buffer.
+ * @param dst Destination view.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @return true if the buffer holds a valid event packet, otherwise false.
+ */
+static inline constexpr bool ble_view_event(
+    event_view_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size)
+{
+	bool ok = true;
+
+	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
+					   src, src_size))
+	{
+		ok = false;
+	}
+	else if (src_size < event_view_t::wire_size)
+	{
+		ok = false;
+	}
+	else
+	{
+		dst = event_view_t{src};
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Obtain a zero-copy view of a received control buffer.
+ * @param dst Destination view.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @return true if the buffer holds a valid control packet, otherwise false.
+ */
+static inline constexpr bool ble_view_control(
+    control_view_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size)
+{
+	bool ok = true;
+
+	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
+					   src, src_size))
+	{
+		ok = false;
+	}
+	else if (src_size < control_view_t::wire_size)
+	{
+		ok = false;
+	}
+	else
+	{
+		dst = control_view_t{src};
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Build a telemetry packet with required defaults.
+ * @param node_id Node ID to embed.
+ * @return Initialised packet.
+ */
+static inline constexpr telemetry_packet_t ble_make_telemetry(
+    ble_node_id_t node_id)
+{
+	telemetry_packet_t pkt{};
+
+	pkt.protocol_version =
+	    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
+	pkt.node_id = static_cast<std::uint8_t>(node_id);
+	pkt.flags = 0u;
+	pkt.primary_value = 0;
+	pkt.secondary_value = 0;
+	pkt.potentiometer_raw = 0u;
+	pkt.duty_commanded = 0u;
+	pkt.reserved = 0u;
+
+	return pkt;
+}
+
+/**
+ * @brief Build an event packet with required defaults.
+ * @param node_id Node ID to embed.
+ * @param type Event type.
+ * @param value Event value.
+ * @param timestamp_ms_mod Timestamp modulo 65536.
+ * @return Initialised packet.
+ */
+static inline constexpr event_packet_t ble_make_event(
+    ble_node_id_t node_id,
+    ble_event_type_t type,
+    std::int16_t value,
+    std::uint16_t timestamp_ms_mod)
+{
+	event_packet_t pkt{};
+
+	pkt.protocol_version =
+	    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
+	pkt.node_id = static_cast<std::uint8_t>(node_id);
+	pkt.event_type = static_cast<std::uint8_t>(type);
+	pkt.event_value = value;
+	pkt.timestamp_ms_mod = timestamp_ms_mod;
+
+	return pkt;
+}
+
+/**
+ * @brief Build a control packet with required defaults.
+ * @param target Target node ID.
+ * @param flags Command flags.
+ * @param duty_override Duty in per-mille 0..1000.
+ * @return Initialised packet.
+ */
+static inline constexpr control_packet_t ble_make_control(
+    ble_node_id_t target,
+    std::uint16_t flags,
+    std::uint16_t duty_override)
+{
+	control_packet_t pkt{};
+
+	pkt.protocol_version =
+	    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
+	pkt.target_node_id = static_cast<std::uint8_t>(target);
+	pkt.command_flags = flags;
+	pkt.duty_override = ble_clamp_duty_per_mille(duty_override);
+	pkt.reserved = 0u;
+
+	return pkt;
+}
+
+/*
+ * Telemetry batching.
+ *
+ * A single telemetry_packet_t uses 14 of the 244 bytes a notification
+ * can carry, and each one costs a radio event. The batch builder below
+ * accumulates samples (one base timestamp plus a 16-bit delta per
+ * sample) and signals a flush once the negotiated payload is full or
+ * the oldest sample reaches its latency deadline, whichever is first.
+ * Samples are encoded into the builder's buffer as they arrive, so a
+ * flush only has to write the header.
+ */
+
+/**
+ * @brief Accumulator for one telemetry batch notification.
+ * @note Initialise with ble_telemetry_batch_init() before use.
+ */
+struct telemetry_batch_builder_t final
+{
+	static constexpr std::size_t header_size =
+	    sizeof(telemetry_batch_header_t);
+	static constexpr std::size_t sample_size =
+	    sizeof(telemetry_batch_sample_t);
+	static constexpr std::size_t max_samples =
+	    (ble_protocol_constants_t::notify_payload_max - header_size) /
+	    sample_size;
+	static constexpr std::uint32_t max_latency_limit_ms = 0xFFFFu;
+
+	std::uint8_t buffer[ble_protocol_constants_t::notify_payload_max];
+	std::size_t sample_capacity;
+	std::uint32_t max_latency_ms;
+	std::uint32_t base_timestamp_ms;
+	std::uint8_t node_id;
+	std::uint8_t sample_count;
+};
+
+static_assert(telemetry_batch_builder_t::max_samples <= 0xFFu,
+	      "telemetry batch sample_count would overflow");
+
+/**
+ * @brief Initialise a telemetry batch builder.
+ * @param builder Builder to initialise.
+ * @param node_id Node ID to embed.
+ * @param payload_size Usable notification payload (ATT MTU - 3).
+ * @param max_latency_ms Longest a sample may wait before a flush.
+ * @return true if the payload fits at least one sample, otherwise false.
+ */
+static inline bool ble_telemetry_batch_init(
+    telemetry_batch_builder_t &builder,
+    ble_node_id_t node_id,
+    std::size_t payload_size,
+    std::uint32_t max_latency_ms)
+{
+	bool ok = true;
+	std::size_t usable = payload_size;
+
+	if (usable > ble_protocol_constants_t::notify_payload_max)
+	{
+		usable = ble_protocol_constants_t::notify_payload_max;
+	}
+
+	if (usable < (telemetry_batch_builder_t::header_size +
+		      telemetry_batch_builder_t::sample_size))
+	{
+		ok = false;
+	}
+	else
+	{
+		builder.sample_capacity =
+		    (usable - telemetry_batch_builder_t::header_size) /
+		    telemetry_batch_builder_t::sample_size;
+		builder.max_latency_ms = max_latency_ms;
+		if (builder.max_latency_ms >
+		    telemetry_batch_builder_t::max_latency_limit_ms)
+		{
+			builder.max_latency_ms =
+			    telemetry_batch_builder_t::max_latency_limit_ms;
+		}
+		builder.base_timestamp_ms = 0u;
+		builder.node_id = static_cast<std::uint8_t>(node_id);
+		builder.sample_count = 0u;
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Discard all samples, e.g. after the batch was transmitted.
+ * @param builder Builder to reset.
+ */
+static inline void ble_telemetry_batch_reset(
+    telemetry_batch_builder_t &builder)
+{
+	builder.sample_count = 0u;
+}
+
+/**
+ * @brief Append a sample to a telemetry batch.
+ * @param builder Builder to append to.
+ * @param sample Telemetry sample (protocol_version and node_id must match).
+ * @param timestamp_ms Sample time in milliseconds (e.g. millis()).
+ * @return true if appended; false if the batch is full, the sample is
+ *	   too far from the base timestamp, or the sample is invalid.
+ *	   Flush and retry on false.
+ */
+static inline bool ble_telemetry_batch_add(
+    telemetry_batch_builder_t &builder,
+    const telemetry_packet_t &sample,
+    std::uint32_t timestamp_ms)
+{
+	bool ok = true;
+	const std::uint32_t delta_ms = (builder.sample_count == 0u)
+					   ? 0u
+					   : (timestamp_ms -
+					      builder.base_timestamp_ms);
+
+	if (sample.protocol_version !=
+	    static_cast<std::uint8_t>(ble_protocol_version_t::v1))
+	{
+		ok = false;
+	}
+	else if (sample.node_id != builder.node_id)
+	{
+		ok = false;
+	}
+	else if (builder.sample_count >= builder.sample_capacity)
+	{
+		ok = false;
+	}
+	else if (delta_ms > telemetry_batch_builder_t::max_latency_limit_ms)
+	{
+		ok = false;
+	}
+	else
+	{
+		telemetry_batch_sample_t record{};
+
+		if (builder.sample_count == 0u)
+		{
+			builder.base_timestamp_ms = timestamp_ms;
+		}
+
+		record.delta_ms = static_cast<std::uint16_t>(delta_ms);
+		record.flags = sample.flags;
+		record.primary_value = sample.primary_value;
+		record.secondary_value = sample.secondary_value;
+		record.potentiometer_raw = sample.potentiometer_raw;
+		record.duty_commanded = sample.duty_commanded;
+
+		ble_telemetry_batch_sample_codec_t::encode(
+		    builder.buffer + telemetry_batch_builder_t::header_size +
+			(builder.sample_count *
+			 telemetry_batch_builder_t::sample_size),
+		    record);
+		builder.sample_count =
+		    static_cast<std::uint8_t>(builder.sample_count + 1u);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Decide whether a telemetry batch should be transmitted now.
+ * @param builder Builder to test.
+ * @param now_ms Current time in milliseconds.
+ * @return true if the batch is full or its oldest sample is due.
+ */
+static inline bool ble_telemetry_batch_should_flush(
+    const telemetry_batch_builder_t &builder,
+    std::uint32_t now_ms)
+{
+	bool flush = false;
+
+	if (builder.sample_count == 0u)
+	{
+		flush = false;
+	}
+	else if (builder.sample_count >= builder.sample_capacity)
+	{
+		flush = true;
+	}
+	else
+	{
+		flush = (now_ms - builder.base_timestamp_ms) >=
+			builder.max_latency_ms;
+	}
+
+	return flush;
+}
+
+/**
+ * @brief Finalise the batch header ready for transmission.
+ * @param builder Builder to finalise.
+ * @return Payload size in bytes at builder.buffer, or 0 if empty.
+ */
+static inline std::size_t ble_telemetry_batch_finish(
+    telemetry_batch_builder_t &builder)
+{
+	std::size_t size = 0u;
+
+	if (builder.sample_count != 0u)
+	{
+		telemetry_batch_header_t header{};
+
+		header.protocol_version =
+		    static_cast<std::uint8_t>(ble_protocol_version_t::v1);
+		header.node_id = builder.node_id;
+		header.batch_format =
+		    static_cast<std::uint8_t>(ble_telemetry_batch_format_t::v1);
+		header.sample_count = builder.sample_count;
+		header.base_timestamp_ms = builder.base_timestamp_ms;
+
+		ble_telemetry_batch_header_codec_t::encode(builder.buffer, header);
+		size = telemetry_batch_builder_t::header_size +
+		       (builder.sample_count *
+			telemetry_batch_builder_t::sample_size);
+	}
+
+	return size;
+}
+
+/**
+ * @brief Read-only view of a received telemetry batch.
+ */
+struct telemetry_batch_view_t final
+{
+	const std::uint8_t *bytes;
+
+	constexpr std::uint8_t node_id() const
+	{
+		return bytes[offsetof(telemetry_batch_header_t, node_id)];
+	}
+
+	constexpr std::uint8_t sample_count() const
+	{
+		return bytes[offsetof(telemetry_batch_header_t, sample_count)];
+	}
+
+	constexpr std::uint32_t base_timestamp_ms() const
+	{
+		return ble_load_le<std::uint32_t>(
+		    bytes + offsetof(telemetry_batch_header_t, base_timestamp_ms));
+	}
+
+	constexpr const std::uint8_t *sample_bytes(std::size_t index) const
+	{
+		return bytes + telemetry_batch_builder_t::header_size +
+		       (index * telemetry_batch_builder_t::sample_size);
+	}
+
+	/**
+	 * @brief Absolute timestamp of a sample.
+	 */
+	constexpr std::uint32_t sample_timestamp_ms(std::size_t index) const
+	{
+		return base_timestamp_ms() +
+		       ble_load_le<std::uint16_t>(sample_bytes(index) +
+				       offsetof(telemetry_batch_sample_t,
+						delta_ms));
+	}
+
+	/**
+	 * @brief Expand a sample into a regular telemetry packet.
+	 */
+	constexpr telemetry_packet_t sample(std::size_t index) const
+	{
+		const std::uint8_t *src = sample_bytes(index);
+		telemetry_packet_t pkt{};
+
+		pkt.protocol_version =
+		    bytes[offsetof(telemetry_batch_header_t, protocol_version)];
+		pkt.node_id = node_id();
+		pkt.flags = ble_load_le<std::uint16_t>(
+		    src + offsetof(telemetry_batch_sample_t, flags));
+		pkt.primary_value = ble_load_le<std::int16_t>(
+		    src + offsetof(telemetry_batch_sample_t, primary_value));
+		pkt.secondary_value = ble_load_le<std::int16_t>(
+		    src + offsetof(telemetry_batch_sample_t, secondary_value));
+		pkt.potentiometer_raw = ble_load_le<std::uint16_t>(
+		    src + offsetof(telemetry_batch_sample_t, potentiometer_raw));
+		pkt.duty_commanded = ble_load_le<std::uint16_t>(
+		    src + offsetof(telemetry_batch_sample_t, duty_commanded));
+		pkt.reserved = 0u;
+
+		return pkt;
+	}
+};
+
+/**
+ * @brief Obtain a view of a received telemetry batch buffer.
+ * @param dst Destination view.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @return true if the buffer holds a complete, supported batch.
+ */
+static inline constexpr bool ble_view_telemetry_batch(
+    telemetry_batch_view_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size)
+{
+	bool ok = true;
+
+	if (!ble_validate_protocol_version(ble_protocol_version_t::v1,
+					   src, src_size))
+	{
+		ok = false;
+	}
+	else if (src_size < telemetry_batch_builder_t::header_size)
+	{
+		ok = false;
+	}
+	else if (src[offsetof(telemetry_batch_header_t, batch_format)] !=
+		 static_cast<std::uint8_t>(ble_telemetry_batch_format_t::v1))
+	{
+		ok = false;
+	}
+	else if (src_size <
+		 (telemetry_batch_builder_t::header_size +
+		  (src[offsetof(telemetry_batch_header_t, sample_count)] *
+		   telemetry_batch_builder_t::sample_size)))
+	{
+		ok = false;
+	}
+	else
+	{
+		dst = telemetry_batch_view_t{src};
+		ok = true;
+	}
+
+	return ok;
+}
+
+/*
+ * Compressed telemetry stream.
+ *
+ * Optional alternative to telemetry_packet_t for the telemetry_stream
+ * characteristic. Samples are sent as frames:
+ *
+ * - Keyframe (14 bytes): header, key_seq, then protocol_version,
+ *   node_id, flags, primary, secondary, potentiometer and duty as
+ *   little-endian integers.
+ * - Delta frame (2..17 bytes): header carrying a field mask, the key_seq
+ *   it references, then one varint per masked field. Signed fields are
+ *   zigzag-encoded differences from the keyframe; flags are XORed.
+ *
+ * Deltas always reference the last acknowledged keyframe, so a lost
+ * delta never corrupts later samples, and a full keyframe is sent every
+ * keyframe_interval frames to bound recovery time. A temperature
+ * change of a few centi-degrees encodes in 3 bytes instead of 14.
+ *
+ * Keyframes are acknowledged implicitly when sent (notifications), or
+ * explicitly through ble_telemetry_stream_acknowledge() when the
+ * transport confirms delivery (indications). The reserved telemetry
+ * field is not transmitted and decodes as 0.
+ */
+
+/**
+ * @brief Frame kinds in the compressed telemetry stream (header bits 7..6).
+ */
+enum class ble_stream_frame_t : std::uint8_t
+{
+	keyframe = 0x80u,
+	delta = 0x40u
+};
+
+/**
+ * @brief Field mask bits in a delta frame header (bits 4..0).
+ */
+enum class ble_stream_field_t : std::uint8_t
+{
+	flags = (1u << 0),
+	primary_value = (1u << 1),
+	secondary_value = (1u << 2),
+	potentiometer_raw = (1u << 3),
+	duty_commanded = (1u << 4)
+};
+
+/**
+ * @brief Compressed stream framing constants.
+ */
+struct ble_stream_constants_t final
+{
+	static constexpr std::uint8_t kind_mask = 0xC0u;
+	static constexpr std::uint8_t field_mask = 0x1Fu;
+	static constexpr std::size_t keyframe_size = 14u;
+	static constexpr std::size_t varint_max_size = 5u;
+	static constexpr std::size_t delta_max_size = 2u + (5u * 3u);
+	static constexpr std::uint16_t keyframe_interval_default = 30u;
+};
+
+/**
+ * @brief Map a signed value onto an unsigned one with small magnitude.
+ * @param value Signed value.
+ * @return Zigzag-encoded value (0, -1, 1, -2 ... -> 0, 1, 2, 3 ...).
+ */
+static inline constexpr std::uint32_t ble_zigzag_encode(std::int32_t value)
+{
+	return (static_cast<std::uint32_t>(value) << 1) ^
+	       static_cast<std::uint32_t>(-(static_cast<std::int32_t>(
+		   static_cast<std::uint32_t>(value) >> 31)));
+}
+
+/**
+ * @brief Inverse of ble_zigzag_encode().
+ * @param value Zigzag-encoded value.
+ * @return Signed value.
+ */
+static inline constexpr std::int32_t ble_zigzag_decode(std::uint32_t value)
+{
+	return static_cast<std::int32_t>((value >> 1) ^ (0u - (value & 1u)));
+}
+
+/**
+ * @brief Write an unsigned LEB128 varint.
+ * @param dst Destination buffer.
+ * @param dst_size Destination buffer size in bytes.
+ * @param value Value to write.
+ * @return Bytes written, or 0 if it does not fit.
+ */
+static inline constexpr std::size_t ble_varint_write(
+    std::uint8_t *dst,
+    std::size_t dst_size,
+    std::uint32_t value)
+{
+	std::size_t used = 0u;
+	std::uint32_t rest = value;
+	bool more = true;
+
+	while (more && (used < dst_size))
+	{
+		dst[used] = static_cast<std::uint8_t>(rest & 0x7Fu);
+		rest >>= 7;
+		more = (rest != 0u);
+		if (more)
+		{
+			dst[used] = static_cast<std::uint8_t>(dst[used] | 0x80u);
+		}
+		++used;
+	}
+
+	return more ? 0u : used;
+}
+
+/**
+ * @brief Read an unsigned LEB128 varint.
+ * @param src Source buffer.
+ * @param src_size Source buffer size in bytes.
+ * @param value Decoded value.
+ * @return Bytes consumed, or 0 if truncated or over-long.
+ */
+static inline constexpr std::size_t ble_varint_read(
+    const std::uint8_t *src,
+    std::size_t src_size,
+    std::uint32_t &value)
+{
+	std::size_t used = 0u;
+	std::uint32_t result = 0u;
+	bool more = true;
+
+	while (more && (used < src_size) &&
+	       (used < ble_stream_constants_t::varint_max_size))
+	{
+		result |= static_cast<std::uint32_t>(src[used] & 0x7Fu)
+			  << (7u * used);
+		more = (src[used] & 0x80u) != 0u;
+		++used;
+	}
+
+	value = result;
+
+	return more ? 0u : used;
+}
+
+/**
+ * @brief Encoder state for the compressed telemetry stream.
+ * @note Initialise with ble_telemetry_stream_encoder_init().
+ */
+struct telemetry_stream_encoder_t final
+{
+	telemetry_packet_t reference;
+	telemetry_packet_t pending;
+	std::uint16_t keyframe_interval;
+	std::uint16_t frames_since_key;
+	std::uint8_t reference_seq;
+	std::uint8_t pending_seq;
+	std::uint8_t next_seq;
+	bool has_reference;
+	bool has_pending;
+	bool implicit_ack;
+	bool force_keyframe;
+};
+
+/**
+ * @brief Decoder state for the compressed telemetry stream.
+ * @note Keeps two keyframes: the one the encoder last referenced (pinned)
+ *	 and the newest one received, so deltas keep decoding while a new
+ *	 keyframe awaits its acknowledgement.
+ */
+struct telemetry_stream_decoder_t final
+{
+	telemetry_packet_t keys[2];
+	std::uint8_t key_seq[2];
+	bool key_valid[2];
+	std::uint8_t pinned;
+};
+
+/**
+ * @brief Initialise a compressed telemetry stream encoder.
+ * @param enc Encoder to initialise.
+ * @param keyframe_interval Frames between forced keyframes (>= 1).
+ * @param implicit_ack true if keyframes count as acknowledged once sent.
+ */
+static inline constexpr void ble_telemetry_stream_encoder_init(
+    telemetry_stream_encoder_t &enc,
+    std::uint16_t keyframe_interval,
+    bool implicit_ack)
+{
+	enc.reference = telemetry_packet_t{};
+	enc.pending = telemetry_packet_t{};
+	enc.keyframe_interval = (keyframe_interval == 0u) ? 1u
+							  : keyframe_interval;
+	enc.frames_since_key = 0u;
+	enc.reference_seq = 0u;
+	enc.pending_seq = 0u;
+	enc.next_seq = 0u;
+	enc.has_reference = false;
+	enc.has_pending = false;
+	enc.implicit_ack = implicit_ack;
+	enc.force_keyframe = true;
+}
+
+/**
+ * @brief Request a keyframe for the next sample (e.g. on reconnect).
+ * @param enc Encoder to update.
+ */
+static inline constexpr void ble_telemetry_stream_force_keyframe(
+    telemetry_stream_encoder_t &enc)
+{
+	enc.force_keyframe = true;
+}
+
+/**
+ * @brief Acknowledge delivery of a keyframe.
+ * @param enc Encoder to update.
+ * @param key_seq Sequence number of the delivered keyframe.
+ * @return true if it matched the outstanding keyframe, otherwise false.
+ */
+static inline constexpr bool ble_telemetry_stream_acknowledge(
+    telemetry_stream_encoder_t &enc,
+    std::uint8_t key_seq)
+{
+	bool ok = false;
+
+	if (enc.has_pending && (enc.pending_seq == key_seq))
+	{
+		enc.reference = enc.pending;
+		enc.reference_seq = enc.pending_seq;
+		enc.has_reference = true;
+		enc.has_pending = false;
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Write a keyframe (internal helper).
+ */
+static inline constexpr std::size_t ble_telemetry_stream_write_keyframe(
+    std::uint8_t *dst,
+    std::uint8_t key_seq,
+    const telemetry_packet_t &sample)
+{
+	dst[0] = static_cast<std::uint8_t>(ble_stream_frame_t::keyframe);
+	dst[1] = key_seq;
+	dst[2] = sample.protocol_version;
+	dst[3] = sample.node_id;
+	ble_store_le<std::uint16_t>(dst + 4u, sample.flags);
+	ble_store_le<std::int16_t>(dst + 6u, sample.primary_value);
+	ble_store_le<std::int16_t>(dst + 8u, sample.secondary_value);
+	ble_store_le<std::uint16_t>(dst + 10u, sample.potentiometer_raw);
+	ble_store_le<std::uint16_t>(dst + 12u, sample.duty_commanded);
+
+	return ble_stream_constants_t::keyframe_size;
+}
+
+/**
+ * @brief Write a delta frame into a scratch buffer (internal helper).
+ * @return Frame size in bytes.
+ */
+static inline constexpr std::size_t ble_telemetry_stream_write_delta(
+    std::uint8_t (&dst)[ble_stream_constants_t::delta_max_size],
+    std::uint8_t key_seq,
+    const telemetry_packet_t &key,
+    const telemetry_packet_t &sample)
+{
+	const std::uint32_t values[5] = {
+	    static_cast<std::uint32_t>(sample.flags ^ key.flags),
+	    ble_zigzag_encode(static_cast<std::int32_t>(sample.primary_value) -
+			      key.primary_value),
+	    ble_zigzag_encode(
+		static_cast<std::int32_t>(sample.secondary_value) -
+		key.secondary_value),
+	    ble_zigzag_encode(
+		static_cast<std::int32_t>(sample.potentiometer_raw) -
+		key.potentiometer_raw),
+	    ble_zigzag_encode(
+		static_cast<std::int32_t>(sample.duty_commanded) -
+		key.duty_commanded)};
+	std::uint8_t mask = 0u;
+	std::size_t used = 2u;
+
+	for (std::size_t i = 0u; i < 5u; ++i)
+	{
+		if (values[i] != 0u)
+		{
+			mask = static_cast<std::uint8_t>(mask | (1u << i));
+			used += ble_varint_write(dst + used, sizeof(dst) - used,
+						 values[i]);
+		}
+	}
+
+	dst[0] = static_cast<std::uint8_t>(
+	    static_cast<std::uint8_t>(ble_stream_frame_t::delta) | mask);
+	dst[1] = key_seq;
+
+	return used;
+}
+
+/**
+ * @brief Encode one telemetry sample as a compressed stream frame.
+ * @param enc Encoder state.
+ * @param dst Destination buffer.
+ * @param dst_size Destination buffer size in bytes.
+ * @param sample Sample to encode.
+ * @param written Bytes written on success.
+ * @return true if a frame was written, otherwise false.
+ */
+static inline constexpr bool ble_telemetry_stream_encode(
+    telemetry_stream_encoder_t &enc,
+    std::uint8_t *dst,
+    std::size_t dst_size,
+    const telemetry_packet_t &sample,
+    std::size_t &written)
+{
+	bool ok = true;
+	std::uint8_t scratch[ble_stream_constants_t::delta_max_size] = {};
+	std::size_t delta_size = 0u;
+	const bool want_key = enc.force_keyframe || !enc.has_reference ||
+			      (enc.frames_since_key >= enc.keyframe_interval);
+
+	if (!want_key)
+	{
+		delta_size = ble_telemetry_stream_write_delta(
+		    scratch, enc.reference_seq, enc.reference, sample);
+	}
+
+	if (dst == nullptr)
+	{
+		ok = false;
+	}
+	else if (sample.protocol_version !=
+		 static_cast<std::uint8_t>(ble_protocol_version_t::v1))
+	{
+		ok = false;
+	}
+	else if (want_key || (sample.node_id != enc.reference.node_id) ||
+		 (delta_size >= ble_stream_constants_t::keyframe_size))
+	{
+		if (dst_size < ble_stream_constants_t::keyframe_size)
+		{
+			ok = false;
+		}
+		else
+		{
+			const std::uint8_t seq = enc.next_seq;
+
+			written = ble_telemetry_stream_write_keyframe(dst, seq,
+								      sample);
+			enc.pending = sample;
+			enc.pending_seq = seq;
+			enc.has_pending = true;
+			enc.next_seq = static_cast<std::uint8_t>(seq + 1u);
+			enc.force_keyframe = false;
+			enc.frames_since_key = 0u;
+			if (enc.implicit_ack)
+			{
+				(void)ble_telemetry_stream_acknowledge(enc, seq);
+			}
+			ok = true;
+		}
+	}
+	else if (dst_size < delta_size)
+	{
+		ok = false;
+	}
+	else
+	{
+		for (std::size_t i = 0u; i < delta_size; ++i)
+		{
+			dst[i] = scratch[i];
+		}
+		written = delta_size;
+		enc.frames_since_key =
+		    static_cast<std::uint16_t>(enc.frames_since_key + 1u);
+		ok = true;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Initialise a compressed telemetry stream decoder.
+ * @param dec Decoder to initialise.
+ */
+static inline constexpr void ble_telemetry_stream_decoder_init(
+    telemetry_stream_decoder_t &dec)
+{
+	for (std::size_t i = 0u; i < 2u; ++i)
+	{
+		dec.keys[i] = telemetry_packet_t{};
+		dec.key_seq[i] = 0u;
+		dec.key_valid[i] = false;
+	}
+	dec.pinned = 0u;
+}
+
+/**
+ * @brief Decode one compressed stream frame into a telemetry packet.
+ * @param dec Decoder state.
+ * @param dst Decoded telemetry packet.
+ * @param src Source buffer (may hold several concatenated frames).
+ * @param src_size Source buffer size in bytes.
+ * @param consumed Bytes consumed by this frame on success.
+ * @return true if a sample was decoded; false on malformed input or a
+ *	   delta against an unknown keyframe (request a keyframe).
+ */
+static inline constexpr bool ble_telemetry_stream_decode(
+    telemetry_stream_decoder_t &dec,
+    telemetry_packet_t &dst,
+    const std::uint8_t *src,
+    std::size_t src_size,
+    std::size_t &consumed)
+{
+	bool ok = true;
+	const std::uint8_t kind = ((src == nullptr) || (src_size < 2u))
+				      ? 0u
+				      : static_cast<std::uint8_t>(
+					    src[0] &
+					    ble_stream_constants_t::kind_mask);
+
+	if (kind == static_cast<std::uint8_t>(ble_stream_frame_t::keyframe))
+	{
+		if ((src_size < ble_stream_constants_t::keyframe_size) ||
+		    (src[2] !=
+		     static_cast<std::uint8_t>(ble_protocol_version_t::v1)))
+		{
+			ok = false;
+		}
+		else
+		{
+			telemetry_packet_t key{};
+			std::uint8_t slot = static_cast<std::uint8_t>(dec.pinned ^ 1u);
+
+			key.protocol_version = src[2];
+			key.node_id = src[3];
+			key.flags = ble_load_le<std::uint16_t>(src + 4u);
+			key.primary_value = ble_load_le<std::int16_t>(src + 6u);
+			key.secondary_value = ble_load_le<std::int16_t>(src + 8u);
+			key.potentiometer_raw =
+			    ble_load_le<std::uint16_t>(src + 10u);
+			key.duty_commanded = ble_load_le<std::uint16_t>(src + 12u);
+			key.reserved = 0u;
+
+			/* Never evict the keyframe deltas currently refer to. */
+			if (dec.key_valid[dec.pinned] &&
+			    (dec.key_seq[dec.pinned] == src[1]))
+			{
+				slot = dec.pinned;
+			}
+			dec.keys[slot] = key;
+			dec.key_seq[slot] = src[1];
+			dec.key_valid[slot] = true;
+
+			dst = key;
+			consumed = ble_stream_constants_t::keyframe_size;
+			ok = true;
+		}
+	}
+	else if (kind == static_cast<std::uint8_t>(ble_stream_frame_t::delta))
+	{
+		std::size_t slot = 2u;
+
+		for (std::size_t i = 0u; i < 2u; ++i)
+		{
+			if (dec.key_valid[i] && (dec.key_seq[i] == src[1]))
+			{
+				slot = i;
+			}
+		}
+
+		if (slot >= 2u)
+		{
+			ok = false;
+		}
+		else
+		{
+			const telemetry_packet_t &key = dec.keys[slot];
+			std::uint32_t values[5] = {0u, 0u, 0u, 0u, 0u};
+			std::size_t used = 2u;
+
+			for (std::size_t i = 0u; ok && (i < 5u); ++i)
+			{
+				if ((src[0] & (1u << i)) != 0u)
+				{
+					const std::size_t n = ble_varint_read(
+					    src + used, src_size - used, values[i]);
+
+					ok = (n != 0u);
+					used += n;
+				}
+			}
+
+			if (ok)
+			{
+				dec.pinned = static_cast<std::uint8_t>(slot);
+				dst = key;
+				dst.flags = static_cast<std::uint16_t>(
+				    key.flags ^ values[0]);
+				dst.primary_value = static_cast<std::int16_t>(
+				    key.primary_value +
+				    ble_zigzag_decode(values[1]));
+				dst.secondary_value = static_cast<std::int16_t>(
+				    key.secondary_value +
+				    ble_zigzag_decode(values[2]));
+				dst.potentiometer_raw = static_cast<std::uint16_t>(
+				    key.potentiometer_raw +
+				    ble_zigzag_decode(values[3]));
+				dst.duty_commanded = static_cast<std::uint16_t>(
+				    key.duty_commanded +
+				    ble_zigzag_decode(values[4]));
+				consumed = used;
+			}
+		}
+	}
+	else
+	{
+		ok = false;
+	}
+
+	return ok;
+}
 
 /*
  * Test vectors (little-endian).
@@ -551,3 +2338,290 @@ static constexpr std::uint8_t BLE_TEST_CTRL_1[8] =
 	0x01u, 0x00u,
 	0xEEu, 0x02u,
 	0x00u, 0x00u};
+
+/*
+ * BATCH_1: SN2 telemetry batch, two samples 1000 ms apart
+ * - protocol_version = 1
+ * - node_id = 2
+ * - batch_format = 1
+ * - sample_count = 2
+ * - base_timestamp_ms = 0x00012345
+ * - sample 0: delta 0, TELEM_1 values
+ * - sample 1: delta 1000, primary_value = 2251, sound cleared
+ */
+static constexpr std::uint8_t BLE_TEST_BATCH_1[32] =
+    {
+	0x01u, 0x02u, 0x01u, 0x02u,
+	0x45u, 0x23u, 0x01u, 0x00u,
+	0x00u, 0x00u,
+	0x01u, 0x00u,
+	0xCAu, 0x08u,
+	0x01u, 0x00u,
+	0x00u, 0x08u,
+	0xF4u, 0x01u,
+	0xE8u, 0x03u,
+	0x01u, 0x00u,
+	0xCBu, 0x08u,
+	0x00u, 0x00u,
+	0x00u, 0x08u,
+	0xF4u, 0x01u};
+
+/*
+ * STREAM_1: compressed SN2 telemetry stream
+ * - keyframe, key_seq = 0, TELEM_1 values
+ * - delta against key 0: primary_value +1 (2251), secondary_value -1 (0)
+ */
+static constexpr std::uint8_t BLE_TEST_STREAM_1[18] =
+    {
+	0x80u, 0x00u,
+	0x01u, 0x02u,
+	0x01u, 0x00u,
+	0xCAu, 0x08u,
+	0x01u, 0x00u,
+	0x00u, 0x08u,
+	0xF4u, 0x01u,
+	0x46u, 0x00u,
+	0x02u, 0x01u};
+
+/*
+ * Compile-time checks of the packet views against the test vectors.
+ *
+ * Each check decodes a test vector in place and re-encodes the expected
+ * packet through the corresponding writer, then repeats the round trip
+ * through the pack/unpack wrappers, proving both are byte-equivalent to
+ * the documented wire format.
+ */
+static inline constexpr bool ble_test_telemetry_view()
+{
+	telemetry_packet_t pkt = ble_make_telemetry(ble_node_id_t::sn2);
+	std::uint8_t buf[sizeof(telemetry_packet_t)] = {};
+	bool ok = true;
+
+	pkt.flags = ble_telemetry_flag_mask(ble_telemetry_flag_t::help_active);
+	pkt.primary_value = 2250;
+	pkt.secondary_value = 1;
+	pkt.potentiometer_raw = 2048u;
+	pkt.duty_commanded = 500u;
+
+	telemetry_writer_t{buf}.assign(pkt);
+	for (std::size_t i = 0u; i < sizeof(buf); ++i)
+	{
+		ok = ok && (buf[i] == BLE_TEST_TELEM_1[i]);
+	}
+
+	std::uint8_t packed[sizeof(telemetry_packet_t)] = {};
+
+	ok = ok && ble_pack_telemetry(packed, sizeof(packed), pkt);
+	for (std::size_t i = 0u; i < sizeof(packed); ++i)
+	{
+		ok = ok && (packed[i] == BLE_TEST_TELEM_1[i]);
+	}
+
+	const telemetry_view_t view{BLE_TEST_TELEM_1};
+
+	ok = ok && (view.node_id() == pkt.node_id);
+	ok = ok && (view.flags() == pkt.flags);
+	ok = ok && (view.primary_value() == pkt.primary_value);
+	ok = ok && (view.secondary_value() == pkt.secondary_value);
+	ok = ok && (view.potentiometer_raw() == pkt.potentiometer_raw);
+	ok = ok && (view.duty_commanded() == pkt.duty_commanded);
+
+	return ok;
+}
+
+static inline constexpr bool ble_test_event_view()
+{
+	const event_packet_t pkt = ble_make_event(
+	    ble_node_id_t::sn1, ble_event_type_t::motion_detected, 1, 0x1234u);
+	std::uint8_t buf[sizeof(event_packet_t)] = {};
+	bool ok = true;
+
+	event_writer_t{buf}.assign(pkt);
+	for (std::size_t i = 0u; i < sizeof(buf); ++i)
+	{
+		ok = ok && (buf[i] == BLE_TEST_EVENT_1[i]);
+	}
+
+	std::uint8_t packed[sizeof(event_packet_t)] = {};
+
+	ok = ok && ble_pack_event(packed, sizeof(packed), pkt);
+	for (std::size_t i = 0u; i < sizeof(packed); ++i)
+	{
+		ok = ok && (packed[i] == BLE_TEST_EVENT_1[i]);
+	}
+
+	const event_view_t view{BLE_TEST_EVENT_1};
+
+	ok = ok && (view.node_id() == pkt.node_id);
+	ok = ok && (view.event_type() == pkt.event_type);
+	ok = ok && (view.event_value() == pkt.event_value);
+	ok = ok && (view.timestamp_ms_mod() == pkt.timestamp_ms_mod);
+
+	return ok;
+}
+
+static inline constexpr bool ble_test_control_view()
+{
+	const control_packet_t expected = ble_make_control(
+	    ble_node_id_t::sn2,
+	    ble_control_flag_mask(ble_control_flag_t::override_enable),
+	    750u);
+	control_view_t view{nullptr};
+	control_packet_t pkt{};
+	std::uint8_t buf[sizeof(control_packet_t)] = {};
+	bool ok = true;
+
+	control_writer_t{buf}.assign(expected);
+	for (std::size_t i = 0u; i < sizeof(buf); ++i)
+	{
+		ok = ok && (buf[i] == BLE_TEST_CTRL_1[i]);
+	}
+
+	ok = ok && ble_view_control(view, BLE_TEST_CTRL_1,
+				    sizeof(BLE_TEST_CTRL_1));
+	pkt = view.to_packet();
+	ok = ok && (pkt.target_node_id == expected.target_node_id);
+	ok = ok && (pkt.command_flags == expected.command_flags);
+	ok = ok && (pkt.duty_override == expected.duty_override);
+
+	control_packet_t unpacked{};
+
+	ok = ok && ble_unpack_control(unpacked, BLE_TEST_CTRL_1,
+				      sizeof(BLE_TEST_CTRL_1));
+	ok = ok && (unpacked.target_node_id == expected.target_node_id);
+	ok = ok && (unpacked.command_flags == expected.command_flags);
+	ok = ok && (unpacked.duty_override == expected.duty_override);
+
+	return ok;
+}
+
+static_assert(ble_test_telemetry_view(),
+	      "telemetry view does not match BLE_TEST_TELEM_1");
+static_assert(ble_test_event_view(),
+	      "event view does not match BLE_TEST_EVENT_1");
+static_assert(ble_test_control_view(),
+	      "control view does not match BLE_TEST_CTRL_1");
+
+/*
+ * Compile-time checks of the field tables against the test vectors.
+ *
+ * These exercise the portable (byte-swapping) path of each codec, which
+ * is the path taken on big-endian hosts, so the tables are verified even
+ * when the build target only ever uses the memcpy path.
+ */
+template <typename Codec, typename Packet, std::size_t N>
+static inline constexpr bool ble_test_codec(const Packet &expected,
+					    const std::uint8_t (&vector)[N])
+{
+	std::uint8_t buf[N] = {};
+	Packet decoded{};
+	bool ok = (Codec::wire_size == N);
+
+	Codec::encode_fields(buf, expected);
+	for (std::size_t i = 0u; i < N; ++i)
+	{
+		ok = ok && (buf[i] == vector[i]);
+	}
+
+	Codec::decode_fields(decoded, vector);
+	Codec::encode_fields(buf, decoded);
+	for (std::size_t i = 0u; i < N; ++i)
+	{
+		ok = ok && (buf[i] == vector[i]);
+	}
+
+	return ok;
+}
+
+static_assert(ble_test_codec<ble_telemetry_codec_t>(
+		  telemetry_view_t{BLE_TEST_TELEM_1}.to_packet(),
+		  BLE_TEST_TELEM_1),
+	      "telemetry codec does not match BLE_TEST_TELEM_1");
+static_assert(ble_test_codec<ble_event_codec_t>(
+		  event_view_t{BLE_TEST_EVENT_1}.to_packet(),
+		  BLE_TEST_EVENT_1),
+	      "event codec does not match BLE_TEST_EVENT_1");
+static_assert(ble_test_codec<ble_control_codec_t>(
+		  control_view_t{BLE_TEST_CTRL_1}.to_packet(),
+		  BLE_TEST_CTRL_1),
+	      "control codec does not match BLE_TEST_CTRL_1");
+
+/*
+ * Compile-time check of the batch view against BATCH_1: the first
+ * sample must expand to exactly TELEM_1.
+ */
+static inline constexpr bool ble_test_telemetry_batch_view()
+{
+	telemetry_batch_view_t view{nullptr};
+	bool ok = ble_view_telemetry_batch(view, BLE_TEST_BATCH_1,
+					   sizeof(BLE_TEST_BATCH_1));
+	std::uint8_t buf[sizeof(telemetry_packet_t)] = {};
+
+	ok = ok && (view.sample_count() == 2u);
+	ok = ok && (view.sample_timestamp_ms(0u) == 0x00012345u);
+	ok = ok && (view.sample_timestamp_ms(1u) == (0x00012345u + 1000u));
+	ok = ok && (view.sample(1u).primary_value == 2251);
+	ok = ok && (view.sample(1u).secondary_value == 0);
+
+	telemetry_writer_t{buf}.assign(view.sample(0u));
+	for (std::size_t i = 0u; i < sizeof(buf); ++i)
+	{
+		ok = ok && (buf[i] == BLE_TEST_TELEM_1[i]);
+	}
+
+	return ok;
+}
+
+static_assert(ble_test_telemetry_batch_view(),
+	      "telemetry batch view does not match BLE_TEST_BATCH_1");
+
+/*
+ * Compile-time round trip of the compressed stream against STREAM_1 and
+ * BATCH_1: encoding the two batch samples must reproduce STREAM_1, and
+ * decoding STREAM_1 must reproduce both samples.
+ */
+static inline constexpr bool ble_test_telemetry_stream()
+{
+	const telemetry_batch_view_t batch{BLE_TEST_BATCH_1};
+	telemetry_stream_encoder_t enc{};
+	telemetry_stream_decoder_t dec{};
+	telemetry_packet_t decoded{};
+	std::uint8_t buf[sizeof(BLE_TEST_STREAM_1)] = {};
+	std::size_t used = 0u;
+	std::size_t n = 0u;
+	bool ok = true;
+
+	ble_telemetry_stream_encoder_init(
+	    enc, ble_stream_constants_t::keyframe_interval_default, true);
+	ok = ok && ble_telemetry_stream_encode(enc, buf, sizeof(buf),
+					       batch.sample(0u), n);
+	used += n;
+	ok = ok && ble_telemetry_stream_encode(enc, buf + used,
+					       sizeof(buf) - used,
+					       batch.sample(1u), n);
+	used += n;
+	ok = ok && (used == sizeof(BLE_TEST_STREAM_1));
+	for (std::size_t i = 0u; i < sizeof(buf); ++i)
+	{
+		ok = ok && (buf[i] == BLE_TEST_STREAM_1[i]);
+	}
+
+	ble_telemetry_stream_decoder_init(dec);
+	used = 0u;
+	ok = ok && ble_telemetry_stream_decode(dec, decoded, BLE_TEST_STREAM_1,
+					       sizeof(BLE_TEST_STREAM_1), n);
+	used += n;
+	ok = ok && (decoded.primary_value == 2250) &&
+	     (decoded.flags == batch.sample(0u).flags);
+	ok = ok && ble_telemetry_stream_decode(
+			   dec, decoded, BLE_TEST_STREAM_1 + used,
+			   sizeof(BLE_TEST_STREAM_1) - used, n);
+	ok = ok && (decoded.primary_value == 2251) &&
+	     (decoded.secondary_value == 0) &&
+	     (decoded.duty_commanded == 500u);
+
+	return ok;
+}
+
+static_assert(ble_test_telemetry_stream(),
+	      "telemetry stream codec does not match BLE_TEST_STREAM_1");
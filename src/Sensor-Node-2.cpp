@@ -1,35 +1,376 @@
-/* 
- * Project myProject
- * Author: Your Name
- * Date: 
- * For comprehensive documentation and examples, please visit:
- * https://docs.particle.io/firmware/best-practices/firmware-template/
+/**
+ * @file	Sensor-Node-2.cpp
+ * @brief	Photon 2 glue for the SN2 application
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Runs the application on the acquisition ring (sn2-acquire.hpp): for
+ * every microphone block the port completes, loop() passes the block to
+ * the detector and the slow-channel scan taken with it to
+ * sn2_app_step(), then tells the port when the next thermistor burst is
+ * due. The glue also drives the fan and LEDs and exposes the SN2 BLE
+ * service. All behaviour lives in sn2-app.cpp so it can also run on the
+ * host.
+ *
+ * Control writes arrive on the BLE (system) thread. The write handler
+ * only validates the packet and posts it to a wait-free latest-value
+ * mailbox (sn2-mailbox.hpp); loop() takes it at the start of the next
+ * iteration. A write superseded before loop() took it is counted in the
+ * mailbox's drops.
+ *
+ * A write that enables the override also drives the fan PWM directly
+ * from the handler (sn2-override.hpp), so the fan responds without
+ * waiting up to a loop() period. The application's own fan writes are
+ * held off until loop() has applied that packet, after which the
+ * application rewrites its duty. The handler-entry to
+ * PWM latency of these writes is published as the "override_latency"
+ * cloud variable.
+ *
+ * After stepping, loop() publishes the telemetry state through a
+ * seqlock (sn2-seqlock.hpp). Readers on other threads, such as the
+ * "telemetry" cloud variable, get a consistent copy without a lock and
+ * never delay loop().
+ *
+ * The board's temperature calibration is read from EEPROM emulation
+ * once in setup(). The "calibrate" cloud function takes the four Q15
+ * coefficients printed by host/cal/sn2-cal-fit ("c0 c1 c2 c3"), stores
+ * them and applies them immediately.
+ *
+ * Built against host/shim, `sn2-native --trace FILE` records everything
+ * loop() feeds the application, and everything it produces, as a replay
+ * trace (host/replay/sn2-trace-recorder.hpp) for sn2-replay.
  */
 
-// Include Particle Device OS APIs
 #include "Particle.h"
 
-// Let Device OS manage the connection to the Particle Cloud
-SYSTEM_MODE(AUTOMATIC);
+#include <cstdio>
+#include <cstdlib>
+
+#include "sn2-acquire.hpp"
+#include "sn2-app.hpp"
+#include "sn2-mailbox.hpp"
+#include "sn2-override.hpp"
+#include "sn2-seqlock.hpp"
 
-// Run the application and system concurrently in separate threads
+#if defined(SN2_HOST_SHIM)
+#include "../host/replay/sn2-trace-recorder.hpp"
+#endif
+
+SYSTEM_MODE(AUTOMATIC);
 SYSTEM_THREAD(ENABLED);
 
-// Show system, cloud connectivity, and application logs over USB
-// View logs with CLI using 'particle serial monitor --follow'
 SerialLogHandler logHandler(LOG_LEVEL_INFO);
 
-// setup() runs once, when the device is first turned on
-void setup() {
-  // Put initialization like pinMode and begin functions here
+namespace
+{
+
+constexpr pin_t sn2_pin_temperature = A0;
+constexpr pin_t sn2_pin_sound = A1;
+constexpr pin_t sn2_pin_potentiometer = A2;
+constexpr pin_t sn2_pin_fan = A5;
+constexpr pin_t sn2_pin_help_button = D3;
+constexpr pin_t sn2_pin_help_led = D7;
+constexpr pin_t sn2_pin_override_led = D6;
+
+constexpr std::uint32_t sn2_fan_pwm_hz = 25000u;
+constexpr int sn2_calibration_eeprom_address = 0;
+
+sn2_app_t g_app;
+sn2_acquire_t g_acquire;
+
+/* Control writes are validated on the BLE thread and applied from loop(). */
+sn2_mailbox_t<control_packet_t> g_control;
+
+/* Override writes also reach the fan PWM straight from the handler. */
+sn2_override_fast_t g_override;
+
+/* Latest telemetry state, written by loop() and read from any thread. */
+sn2_seqlock_t<sn2_telemetry_snapshot_t> g_telemetry;
+
+const BleUuid g_service_uuid(ble_uuid_t::service);
+
+BleCharacteristic g_telemetry_char("telemetry", BleCharacteristicProperty::NOTIFY,
+				   BleUuid(ble_uuid_t::telemetry), g_service_uuid);
+BleCharacteristic g_event_char("event", BleCharacteristicProperty::NOTIFY,
+			       BleUuid(ble_uuid_t::event), g_service_uuid);
+
+void sn2_on_control(const std::uint8_t *data, std::size_t size,
+		    const BlePeerDevice &peer, void *context)
+{
+	(void)peer;
+	(void)context;
+
+	const std::uint32_t start_us = micros();
+	control_packet_t pkt{};
+
+	if (sn2_control_parse(pkt, data, size))
+	{
+		/* Post first: a counted fast write must already be in the mailbox. */
+		(void)sn2_mailbox_post(g_control, pkt);
+		if (sn2_override_fast_apply(g_override, pkt))
+		{
+			sn2_override_fast_record(g_override, micros() - start_us);
+		}
+	}
+}
+
+BleCharacteristic g_control_char("control",
+				 BleCharacteristicProperty::WRITE |
+				     BleCharacteristicProperty::WRITE_WO_RSP,
+				 BleUuid(ble_uuid_t::control), g_service_uuid,
+				 sn2_on_control, nullptr);
+
+void sn2_notify(void *context, sn2_channel_t channel, const std::uint8_t *data,
+		std::size_t size)
+{
+	(void)context;
+
+	if (BLE.connected())
+	{
+		if (channel == sn2_channel_t::telemetry)
+		{
+			g_telemetry_char.setValue(data, size);
+		}
+		else
+		{
+			g_event_char.setValue(data, size);
+		}
+	}
+}
+
+void sn2_fan_pwm_write(void *context, std::uint16_t duty_per_mille)
+{
+	(void)context;
+	analogWrite(sn2_pin_fan,
+		    (static_cast<std::uint32_t>(duty_per_mille) * 255u) /
+			ble_protocol_constants_t::duty_per_mille_max,
+		    sn2_fan_pwm_hz);
+}
+
+void sn2_set_fan_duty(void *context, std::uint16_t duty_per_mille)
+{
+	(void)context;
+	sn2_override_fast_app_write(g_override, duty_per_mille);
+}
+
+void sn2_set_leds(void *context, bool help_led, bool override_led)
+{
+	(void)context;
+	digitalWrite(sn2_pin_help_led, help_led ? HIGH : LOW);
+	digitalWrite(sn2_pin_override_led, override_led ? HIGH : LOW);
+}
+
+sn2_io_t g_io = {nullptr, sn2_notify, sn2_set_fan_duty, sn2_set_leds};
+
+#if defined(SN2_HOST_SHIM)
+/* Replay trace of the run, if sn2-native was given --trace. */
+sn2_trace_recorder_t g_trace;
+#endif
+
+void sn2_trace_control(const control_packet_t &pkt)
+{
+#if defined(SN2_HOST_SHIM)
+	sn2_trace_recorder_control(g_trace, millis(), pkt);
+#else
+	(void)pkt;
+#endif
+}
+
+void sn2_trace_block(const std::uint16_t *block, const sn2_inputs_t &scan)
+{
+#if defined(SN2_HOST_SHIM)
+	sn2_trace_recorder_sound(g_trace, block, scan.now_ms);
+#else
+	(void)block;
+	(void)scan;
+#endif
+}
+
+void sn2_trace_scan(const sn2_inputs_t &scan)
+{
+#if defined(SN2_HOST_SHIM)
+	sn2_trace_recorder_input(g_trace, scan);
+#else
+	(void)scan;
+#endif
+}
+
+sn2_calibration_t sn2_calibration_load()
+{
+	std::uint8_t record[sn2_calibration_constants_t::record_size];
+	sn2_calibration_t cal = sn2_calibration_identity();
+
+	EEPROM.get(sn2_calibration_eeprom_address, record);
+	if (!sn2_calibration_unpack(record, sizeof(record), cal))
+	{
+		Log.warn("no valid temperature calibration, using identity");
+	}
+
+	return cal;
+}
+
+/* Cloud functions run on the application thread, between loop() calls. */
+int sn2_on_calibrate(String arg)
+{
+	sn2_calibration_t cal = sn2_calibration_identity();
+	std::uint8_t record[sn2_calibration_constants_t::record_size];
+	const char *p = arg.c_str();
+	char *end = nullptr;
+	std::size_t count = 0u;
+
+	cal.degree = 0u;
+	for (; count <= sn2_calibration_constants_t::max_degree; ++count)
+	{
+		const long c = std::strtol(p, &end, 10);
+
+		if (end == p)
+		{
+			break;
+		}
+		cal.coeff[count] = static_cast<std::int32_t>(c);
+		cal.degree = (c != 0) ? static_cast<std::uint8_t>(count) : cal.degree;
+		p = end;
+	}
+
+	const bool ok = (count == (sn2_calibration_constants_t::max_degree + 1u)) &&
+			(*p == '\0');
+
+	if (ok)
+	{
+		sn2_calibration_pack(record, cal);
+		EEPROM.put(sn2_calibration_eeprom_address, record);
+		g_app.config.calibration = cal;
+		Log.info("temperature calibration stored (degree %u)", cal.degree);
+	}
+
+	return ok ? static_cast<int>(cal.degree) : -1;
+}
+
+/* Calculated cloud variable, evaluated on the system thread. */
+String sn2_telemetry_variable()
+{
+	sn2_telemetry_snapshot_t snap{};
+	char text[160];
+
+	(void)sn2_seqlock_read(g_telemetry, snap);
+	std::snprintf(text, sizeof(text),
+		      "{\"ms\":%lu,\"flags\":%u,\"temperature\":%d,\"sound\":%d,"
+		      "\"potentiometer\":%u,\"duty\":%u}",
+		      static_cast<unsigned long>(snap.timestamp_ms),
+		      static_cast<unsigned>(snap.packet.flags),
+		      static_cast<int>(snap.packet.primary_value),
+		      static_cast<int>(snap.packet.secondary_value),
+		      static_cast<unsigned>(snap.packet.potentiometer_raw),
+		      static_cast<unsigned>(snap.packet.duty_commanded));
+
+	return String(text);
 }
 
-// loop() runs over and over again, as quickly as it can execute.
-void loop() {
-  // The core of your code will likely live here.
+/* Calculated cloud variable, evaluated on the system thread. */
+String sn2_override_latency_variable()
+{
+	sn2_override_latency_t latency{};
+	char text[96];
+
+	sn2_override_fast_latency(g_override, latency);
+	std::snprintf(text, sizeof(text),
+		      "{\"count\":%lu,\"last_us\":%lu,\"mean_us\":%lu,\"max_us\":%lu}",
+		      static_cast<unsigned long>(latency.count),
+		      static_cast<unsigned long>(latency.last_us),
+		      static_cast<unsigned long>(
+			  (latency.count != 0u) ? (latency.total_us / latency.count) : 0u),
+		      static_cast<unsigned long>(latency.max_us));
+
+	return String(text);
+}
+
+} // namespace
+
+void setup()
+{
+	pinMode(sn2_pin_help_button, INPUT_PULLUP);
+	pinMode(sn2_pin_help_led, OUTPUT);
+	pinMode(sn2_pin_override_led, OUTPUT);
+	pinMode(sn2_pin_fan, OUTPUT);
+
+	sn2_config_t config = sn2_default_config();
+
+	config.calibration = sn2_calibration_load();
+	sn2_app_init(g_app, config);
+#if defined(SN2_HOST_SHIM)
+	if ((shim_trace_path() != nullptr) &&
+	    !sn2_trace_recorder_open(g_trace, shim_trace_path(), g_io, g_io))
+	{
+		Log.error("cannot create trace %s", shim_trace_path());
+	}
+#endif
+	sn2_mailbox_init(g_control);
+	sn2_override_fast_init(g_override, sn2_pwm_port_t{nullptr, sn2_fan_pwm_write});
+
+	sn2_telemetry_snapshot_t snap{};
+
+	sn2_app_snapshot(g_app, millis(), snap);
+	sn2_seqlock_init(g_telemetry, snap);
+	Particle.variable("telemetry", sn2_telemetry_variable);
+	Particle.variable("override_latency", sn2_override_latency_variable);
+	Particle.function("calibrate", sn2_on_calibrate);
+	sn2_acquire_init(g_acquire,
+			 sn2_acquire_pins_t{sn2_pin_temperature, sn2_pin_sound,
+					    sn2_pin_potentiometer, sn2_pin_help_button},
+			 config.temperature_oversample_bits, millis());
+	if (!sn2_acquire_port_start(g_acquire))
+	{
+		Log.error("acquisition port failed to start");
+	}
+
+	BLE.addCharacteristic(g_telemetry_char);
+	BLE.addCharacteristic(g_event_char);
+	BLE.addCharacteristic(g_control_char);
+
+	BleAdvertisingData adv;
+	adv.appendServiceUUID(g_service_uuid);
+	BLE.advertise(&adv);
+}
+
+void loop()
+{
+	sn2_inputs_t scan{};
+	const std::uint16_t *block = nullptr;
+	bool stepped = false;
+	control_packet_t control{};
+	const std::uint32_t override_mark = sn2_override_fast_mark(g_override);
+
+	if (sn2_mailbox_take(g_control, control))
+	{
+		sn2_trace_control(control);
+		sn2_app_apply_control(g_app, control);
+	}
+	if (sn2_override_fast_sync(g_override, override_mark))
+	{
+		sn2_app_invalidate_outputs(g_app);
+	}
+
+	/* One step per block, on the scan taken at the end of that block. */
+	while (sn2_sampler_peek(g_acquire.ring, block, scan))
+	{
+		sn2_trace_block(block, scan);
+		sn2_app_sound(g_app, block, sn2_sound_constants_t::block_samples,
+			      scan.now_ms, g_io);
+		sn2_sampler_release(g_acquire.ring);
+		sn2_trace_scan(scan);
+		sn2_app_step(g_app, scan, g_io);
+		sn2_acquire_request_temperature(
+		    g_acquire, sn2_app_temperature_deadline(g_app, scan.now_ms));
+		stepped = true;
+	}
+
+	if (stepped)
+	{
+		sn2_telemetry_snapshot_t snap{};
 
-  // Example: Publish event to cloud every 10 seconds. Uncomment the next 3 lines to try it!
-  // Log.info("Sending Hello World to the cloud!");
-  // Particle.publish("Hello world!");
-  // delay( 10 * 1000 ); // milliseconds and blocking - see docs for more info!
+		sn2_app_snapshot(g_app, scan.now_ms, snap);
+		sn2_seqlock_write(g_telemetry, snap);
+	}
 }
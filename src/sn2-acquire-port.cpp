@@ -0,0 +1,111 @@
+/**
+ * @file	sn2-acquire-port.cpp
+ * @brief	Photon 2 acquisition port
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Device OS exposes neither timer-triggered ADC conversions, ADC DMA nor
+ * a user timer interrupt on the P2, so a dedicated thread stands in for
+ * the DMA engine. It sleeps until each 1 ms RTOS tick and reads the
+ * microphone samples due in that tick back-to-back, so the thread is
+ * awake only for the conversions themselves and the rest of the
+ * millisecond goes to loop() and the system thread (BLE included).
+ *
+ * The price is bounded jitter. A sample's nominal time is on the
+ * 125 us grid of sample_rate_hz; its actual time is the tick plus the
+ * scheduling latency plus the conversions before it in the tick, so the
+ * error stays under one tick and never accumulates. The detector
+ * follows the band energy envelope over 8 ms blocks, which this
+ * grouping preserves; the exact spectrum of a tick is not. Even 8 kHz
+ * sampling would take a hardware timer-triggered ADC through the RTL872x
+ * HAL; a micros() spin-wait thread does it only by holding the CPU for
+ * most of every millisecond.
+ *
+ * A due thermistor burst is spread over the block, an even share after
+ * each tick's microphone reads, so it never delays a sample. The rest
+ * of the scan (sn2_acquire_scan_with()) runs after the last tick of the
+ * block. This thread is the only caller of analogRead().
+ */
+
+#include "Particle.h"
+
+#include "sn2-acquire.hpp"
+
+namespace
+{
+
+constexpr std::uint32_t sn2_acquire_tick_ms = 1u;
+constexpr std::size_t sn2_sound_per_tick =
+    sn2_sound_constants_t::sample_rate_hz / 1000u;
+constexpr std::size_t sn2_ticks_per_block =
+    sn2_sound_constants_t::block_samples / sn2_sound_per_tick;
+
+static_assert((sn2_sound_constants_t::block_samples % sn2_sound_per_tick) == 0u,
+	      "sound block must hold a whole number of ticks");
+
+std::int32_t sn2_acquire_analog(std::uint16_t pin)
+{
+	return analogRead(static_cast<pin_t>(pin));
+}
+
+bool sn2_acquire_digital(std::uint16_t pin)
+{
+	return digitalRead(static_cast<pin_t>(pin)) == HIGH;
+}
+
+void sn2_acquire_thread(void *param)
+{
+	sn2_acquire_t &acq = *static_cast<sn2_acquire_t *>(param);
+	const pin_t sound = static_cast<pin_t>(acq.pins.sound);
+	const pin_t temperature = static_cast<pin_t>(acq.pins.temperature);
+	const std::uint32_t burst_count = sn2_oversample_count(acq.temperature_bits);
+	system_tick_t wake = millis();
+
+	for (;;)
+	{
+		std::uint16_t *block = sn2_sampler_fill(acq.ring);
+		const bool burst = sn2_acquire_temperature_due(
+		    acq, millis() + sn2_acquire_constants_t::block_ms);
+		std::uint32_t burst_sum = 0u;
+		std::uint32_t burst_reads = 0u;
+
+		for (std::size_t tick = 0u; tick < sn2_ticks_per_block; ++tick)
+		{
+			os_thread_delay_until(&wake, sn2_acquire_tick_ms);
+
+			std::uint16_t *samples = block + (tick * sn2_sound_per_tick);
+
+			for (std::size_t i = 0u; i < sn2_sound_per_tick; ++i)
+			{
+				samples[i] = static_cast<std::uint16_t>(analogRead(sound));
+			}
+
+			/* Even share of the burst up to and including this tick. */
+			while (burst && ((burst_reads * sn2_ticks_per_block) <
+					 (burst_count * (tick + 1u))))
+			{
+				burst_sum += static_cast<std::uint32_t>(analogRead(temperature));
+				++burst_reads;
+			}
+		}
+
+		(void)sn2_sampler_commit(
+		    acq.ring,
+		    sn2_acquire_scan_with(acq, millis(), burst,
+					  sn2_oversample_decimate(burst_sum, acq.temperature_bits),
+					  sn2_acquire_analog, sn2_acquire_digital));
+	}
+}
+
+} // namespace
+
+bool sn2_acquire_port_start(sn2_acquire_t &acq)
+{
+	/* Above the application thread so loop() work cannot delay a tick. */
+	static Thread thread("sn2-acquire", sn2_acquire_thread, &acq,
+			     OS_THREAD_PRIORITY_DEFAULT + 1, 1024);
+
+	return thread.isValid();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file	sn2-acquire.hpp
+ * @brief	Single-owner, coherent ADC acquisition for all SN2 channels
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * One producer (the platform port) owns the ADC. It samples the
+ * microphone into blocks and ends every block with a scan of the slow
+ * channels in a fixed sequence: the thermistor burst when one is due,
+ * then the potentiometer, then the help button. The scan is an sn2_inputs_t
+ * stamped with the block's completion time, and it is published in the
+ * same ring entry as the block (sn2-sampler.hpp).
+ *
+ * loop() never calls analogRead(). For each entry it runs the block
+ * through sn2_app_sound() and the scan through sn2_app_step(), so the
+ * temperature, the sound state and the potentiometer reading in one
+ * telemetry packet all describe the same instant. The slow channels
+ * cost one conversion per block (125 Hz) instead of one per loop()
+ * iteration.
+ *
+ * The thermistor burst is taken by the first scan at or after the
+ * deadline that loop() publishes from sn2_app_temperature_deadline()
+ * after each step. The step that consumes that scan is therefore also
+ * the one in which telemetry fires.
+ *
+ * Device OS exposes no multi-channel scan mode or ADC DMA on the P2, so
+ * the sequence is a series of conversions on the port's thread. A port
+ * that must not delay the microphone reads spreads the thermistor burst
+ * over the block instead, a share after each group of reads, and ends
+ * the block with sn2_acquire_scan_with().
+ * A DMA port would keep the same ring calls and run the scan from the
+ * transfer-complete interrupt.
+ *
+ * The port is platform-specific: sn2-acquire-port.cpp on the Photon 2,
+ * host/shim/sn2-acquire-port-fake.cpp for native builds.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "sn2-app.hpp"
+#include "sn2-oversample.hpp"
+#include "sn2-sampler.hpp"
+#include "sn2-sound.hpp"
+
+/**
+ * @brief Acquisition constants.
+ */
+struct sn2_acquire_constants_t final
+{
+	static constexpr std::size_t blocks = 4u;
+	static constexpr std::uint32_t block_ms = static_cast<std::uint32_t>(
+	    (1000u * sn2_sound_constants_t::block_samples) / sn2_sound_constants_t::sample_rate_hz);
+};
+
+/**
+ * @brief Ring of microphone blocks, each tagged with its scan.
+ */
+typedef sn2_sampler_t<sn2_sound_constants_t::block_samples,
+		      sn2_acquire_constants_t::blocks,
+		      sn2_inputs_t>
+    sn2_acquire_ring_t;
+
+/**
+ * @brief Pins of the acquired channels.
+ */
+struct sn2_acquire_pins_t final
+{
+	std::uint16_t temperature;
+	std::uint16_t sound;
+	std::uint16_t potentiometer;
+	std::uint16_t help_button; /* active low */
+};
+
+/**
+ * @brief Acquisition state shared by the port and loop().
+ */
+struct sn2_acquire_t final
+{
+	sn2_acquire_ring_t ring;
+	sn2_acquire_pins_t pins;
+	std::uint8_t temperature_bits;
+
+	/* Written by loop(), read by the port. */
+	std::atomic<std::uint32_t> temperature_deadline_ms;
+};
+
+/**
+ * @brief Initialise acquisition state before starting the port.
+ * @param acq Acquisition state.
+ * @param pins Channel pins.
+ * @param temperature_bits Thermistor oversampling bits.
+ * @param now_ms Current time; the first scan takes a thermistor burst.
+ */
+static inline void sn2_acquire_init(sn2_acquire_t &acq,
+				    const sn2_acquire_pins_t &pins,
+				    std::uint8_t temperature_bits,
+				    std::uint32_t now_ms)
+{
+	sn2_sampler_init(acq.ring);
+	acq.pins = pins;
+	acq.temperature_bits = temperature_bits;
+	acq.temperature_deadline_ms.store(now_ms, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Consumer: publish when the next thermistor burst is due.
+ */
+static inline void sn2_acquire_request_temperature(sn2_acquire_t &acq,
+						   std::uint32_t deadline_ms)
+{
+	acq.temperature_deadline_ms.store(deadline_ms, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Producer: whether the scan at now_ms carries a thermistor burst.
+ */
+static inline bool sn2_acquire_temperature_due(const sn2_acquire_t &acq, std::uint32_t now_ms)
+{
+	const std::uint32_t deadline =
+	    acq.temperature_deadline_ms.load(std::memory_order_relaxed);
+
+	return static_cast<std::int32_t>(now_ms - deadline) >= 0;
+}
+
+/**
+ * @brief Producer: scan the slow channels at the end of a block, with
+ *	  the thermistor burst already taken.
+ * @param acq Acquisition state.
+ * @param now_ms Block completion time, the timestamp of the scan.
+ * @param temperature_fresh Whether a burst was taken for this block.
+ * @param temperature_raw Decimated burst, if temperature_fresh.
+ * @param analog_read Callable (pin) returning one ADC conversion.
+ * @param digital_read Callable (pin) returning true for a high level.
+ * @return The scan, ready to commit with the block.
+ */
+template <typename AnalogRead, typename DigitalRead>
+static inline sn2_inputs_t sn2_acquire_scan_with(const sn2_acquire_t &acq,
+						 std::uint32_t now_ms,
+						 bool temperature_fresh,
+						 std::uint16_t temperature_raw,
+						 AnalogRead analog_read,
+						 DigitalRead digital_read)
+{
+	sn2_inputs_t scan{};
+
+	scan.now_ms = now_ms;
+	scan.potentiometer_raw = static_cast<std::uint16_t>(analog_read(acq.pins.potentiometer));
+	scan.temperature_fresh = temperature_fresh;
+	scan.temperature_raw = temperature_fresh ? temperature_raw : 0u;
+	scan.help_button = !digital_read(acq.pins.help_button);
+
+	return scan;
+}
+
+/**
+ * @brief Producer: scan the slow channels at the end of a block, taking
+ *	  a due thermistor burst back-to-back.
+ * @param acq Acquisition state.
+ * @param now_ms Block completion time, the timestamp of the scan.
+ * @param analog_read Callable (pin) returning one ADC conversion.
+ * @param digital_read Callable (pin) returning true for a high level.
+ * @return The scan, ready to commit with the block.
+ */
+template <typename AnalogRead, typename DigitalRead>
+static inline sn2_inputs_t sn2_acquire_scan(const sn2_acquire_t &acq,
+					    std::uint32_t now_ms,
+					    AnalogRead analog_read,
+					    DigitalRead digital_read)
+{
+	const bool fresh = sn2_acquire_temperature_due(acq, now_ms);
+	const std::uint16_t raw =
+	    fresh ? sn2_oversample_burst(
+			[&acq, &analog_read] { return analog_read(acq.pins.temperature); },
+			acq.temperature_bits)
+		  : 0u;
+
+	return sn2_acquire_scan_with(acq, now_ms, fresh, raw, analog_read, digital_read);
+}
+
+/**
+ * @brief Start the platform acquisition port.
+ * @param acq Acquisition state, initialised with sn2_acquire_init().
+ * @return true if acquisition started, otherwise false.
+ */
+bool sn2_acquire_port_start(sn2_acquire_t &acq);
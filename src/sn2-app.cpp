@@ -0,0 +1,356 @@
+/**
+ * @file	sn2-app.cpp
+ * @brief	Platform-independent SN2 application logic
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ */
+
+#include "sn2-app.hpp"
+
+namespace
+{
+
+/* Open (full scale) or shorted (zero) thermistor divider. */
+bool sn2_temperature_in_range(const sn2_config_t &config, std::uint16_t raw)
+{
+	const std::uint32_t full = static_cast<std::uint32_t>(config.adc_max)
+				   << config.temperature_oversample_bits;
+
+	return (raw != 0u) && (raw < full);
+}
+
+/* |a - b| > deadband, without overflow. */
+bool sn2_outside_deadband(std::int32_t a, std::int32_t b, std::uint16_t deadband)
+{
+	const std::int32_t moved = (a > b) ? (a - b) : (b - a);
+
+	return moved > static_cast<std::int32_t>(deadband);
+}
+
+/* Whether pkt differs enough from the last packet sent to report it. */
+bool sn2_telemetry_changed(const sn2_app_t &app,
+			   const telemetry_packet_t &pkt,
+			   std::uint32_t now_ms)
+{
+	const telemetry_packet_t &last = app.telemetry_sent;
+
+	return !app.config.telemetry_on_change || !app.telemetry_sent_valid ||
+	       ((now_ms - app.telemetry_sent_ms) >= app.config.telemetry_heartbeat_ms) ||
+	       sn2_outside_deadband(pkt.primary_value, last.primary_value,
+				    app.config.telemetry_deadband_centi) ||
+	       sn2_outside_deadband(pkt.duty_commanded, last.duty_commanded,
+				    app.config.telemetry_deadband_duty) ||
+	       (pkt.flags != last.flags) || (pkt.secondary_value != last.secondary_value);
+}
+
+void sn2_notify_telemetry(sn2_app_t &app, const sn2_io_t &io, std::uint32_t now_ms)
+{
+	sn2_telemetry_snapshot_t snap{};
+
+	sn2_app_snapshot(app, now_ms, snap);
+	if (snap.frame_valid && sn2_telemetry_changed(app, snap.packet, now_ms))
+	{
+		app.telemetry_sent = snap.packet;
+		app.telemetry_sent_ms = now_ms;
+		app.telemetry_sent_valid = true;
+		if (io.notify != nullptr)
+		{
+			io.notify(io.context, sn2_channel_t::telemetry, snap.frame,
+				  sizeof(snap.frame));
+		}
+	}
+}
+
+void sn2_notify_event(const sn2_io_t &io,
+		      ble_event_type_t type,
+		      std::int16_t value,
+		      std::uint32_t now_ms)
+{
+	const event_packet_t pkt = ble_make_event(
+	    ble_node_id_t::sn2, type, value,
+	    static_cast<std::uint16_t>(now_ms & 0xFFFFu));
+	std::uint8_t bytes[sizeof(event_packet_t)];
+
+	if (ble_pack_event(bytes, sizeof(bytes), pkt) && (io.notify != nullptr))
+	{
+		io.notify(io.context, sn2_channel_t::event, bytes, sizeof(bytes));
+	}
+}
+
+/* Rate-limited events: at most one per type per event_lockout_ms. */
+void sn2_notify_gated_event(sn2_app_t &app,
+			    const sn2_io_t &io,
+			    ble_event_type_t type,
+			    std::int16_t value,
+			    std::uint32_t now_ms)
+{
+	sn2_event_gate_t &gate = app.gates[static_cast<std::size_t>(type)];
+
+	if (!gate.sent ||
+	    ((now_ms - gate.last_ms) >= ble_protocol_constants_t::event_lockout_ms))
+	{
+		gate.sent = true;
+		gate.last_ms = now_ms;
+		sn2_notify_event(io, type, value, now_ms);
+	}
+}
+
+/* Restart the debounce timer on every raw edge. */
+void sn2_update_button(sn2_app_t &app, const sn2_inputs_t &in)
+{
+	if (in.help_button != app.button_candidate)
+	{
+		app.button_candidate = in.help_button;
+		sn2_timer_start(app.wheel, app.debounce_timer,
+				in.now_ms + app.config.button_debounce_ms, 0u);
+	}
+}
+
+/* One PI tick per valid temperature reading; follows the override. */
+void sn2_update_fan_loop(sn2_app_t &app)
+{
+	if (app.override_active)
+	{
+		sn2_pi_track(app.fan_pi, app.config.fan_pi, app.temperature_centi,
+			     app.duty_override);
+	}
+	else
+	{
+		(void)sn2_pi_update(app.fan_pi, app.config.fan_pi, app.temperature_centi);
+	}
+}
+
+void sn2_update_outputs(sn2_app_t &app, const sn2_io_t &io)
+{
+	const std::uint32_t local =
+	    app.config.fan_closed_loop
+		? app.fan_pi.output
+		: (static_cast<std::uint32_t>(app.potentiometer_raw) *
+		   ble_protocol_constants_t::duty_per_mille_max) /
+		      app.config.adc_max;
+	const std::uint16_t duty =
+	    app.override_active ? app.duty_override
+				: ble_clamp_duty_per_mille(
+				      static_cast<std::uint16_t>(local));
+
+	if (!app.outputs_valid || (duty != app.duty_commanded))
+	{
+		app.duty_commanded = duty;
+		if (io.set_fan_duty != nullptr)
+		{
+			io.set_fan_duty(io.context, duty);
+		}
+	}
+
+	if (io.set_leds != nullptr)
+	{
+		io.set_leds(io.context, app.help_active && app.help_led_phase,
+			    app.override_active);
+	}
+
+	app.outputs_valid = true;
+}
+
+void sn2_on_telemetry(void *context, sn2_timer_t &timer, std::uint32_t now_ms)
+{
+	sn2_app_t &app = *static_cast<sn2_app_t *>(context);
+
+	(void)timer;
+	sn2_notify_telemetry(app, *app.io, now_ms);
+}
+
+/* The raw button level held for button_debounce_ms. */
+void sn2_on_debounce(void *context, sn2_timer_t &timer, std::uint32_t now_ms)
+{
+	sn2_app_t &app = *static_cast<sn2_app_t *>(context);
+
+	(void)timer;
+	if (app.button_candidate != app.button_stable)
+	{
+		app.button_stable = app.button_candidate;
+		if (app.button_stable)
+		{
+			app.help_active = !app.help_active;
+			app.help_led_phase = true;
+			if (app.help_active)
+			{
+				sn2_timer_start(app.wheel, app.blink_timer,
+						now_ms + app.config.help_blink_ms,
+						app.config.help_blink_ms);
+			}
+			else
+			{
+				sn2_timer_stop(app.wheel, app.blink_timer);
+			}
+			sn2_notify_event(*app.io, ble_event_type_t::help_toggled,
+					 app.help_active ? 1 : 0, now_ms);
+			sn2_update_outputs(app, *app.io);
+		}
+	}
+}
+
+void sn2_on_blink(void *context, sn2_timer_t &timer, std::uint32_t now_ms)
+{
+	sn2_app_t &app = *static_cast<sn2_app_t *>(context);
+
+	(void)timer;
+	(void)now_ms;
+	app.help_led_phase = !app.help_led_phase;
+	sn2_update_outputs(app, *app.io);
+}
+
+} // namespace
+
+std::int16_t sn2_temperature_centi(const sn2_config_t &config, std::uint16_t raw)
+{
+	std::int16_t centi = 0;
+
+	if (sn2_temperature_in_range(config, raw))
+	{
+		centi = sn2_thermistor_centi(*config.thermistor, raw,
+					     config.temperature_oversample_bits);
+	}
+
+	return centi;
+}
+
+void sn2_app_snapshot(const sn2_app_t &app,
+		      std::uint32_t now_ms,
+		      sn2_telemetry_snapshot_t &snap)
+{
+	telemetry_packet_t pkt = ble_make_telemetry(ble_node_id_t::sn2);
+	std::uint16_t flags = 0u;
+
+	if (app.help_active)
+	{
+		flags |= static_cast<std::uint16_t>(ble_telemetry_flag_t::help_active);
+	}
+	if (app.override_active)
+	{
+		flags |= static_cast<std::uint16_t>(
+		    ble_telemetry_flag_t::override_active);
+	}
+	if (app.sensor_fault)
+	{
+		flags |= static_cast<std::uint16_t>(ble_telemetry_flag_t::sensor_fault);
+	}
+
+	pkt.flags = flags;
+	pkt.primary_value = app.temperature_centi;
+	pkt.secondary_value = app.sound.state ? 1 : 0;
+	pkt.potentiometer_raw = app.potentiometer_raw;
+	pkt.duty_commanded = app.duty_commanded;
+
+	snap.timestamp_ms = now_ms;
+	snap.packet = pkt;
+	snap.frame_valid = ble_pack_telemetry(snap.frame, sizeof(snap.frame), pkt);
+}
+
+void sn2_app_init(sn2_app_t &app, const sn2_config_t &config)
+{
+	app = sn2_app_t{};
+	app.config = config;
+	app.help_led_phase = true;
+	sn2_median_init(app.temperature_median);
+	sn2_median_init(app.potentiometer_median);
+	sn2_pi_init(app.fan_pi, config.fan_pi);
+	sn2_sound_init(app.sound, config.sound_min_margin, config.sound_deviations,
+		       config.sound_floor_shift);
+	sn2_timer_init(app.telemetry_timer, sn2_on_telemetry, &app);
+	sn2_timer_init(app.debounce_timer, sn2_on_debounce, &app);
+	sn2_timer_init(app.blink_timer, sn2_on_blink, &app);
+}
+
+void sn2_app_step(sn2_app_t &app, const sn2_inputs_t &in, const sn2_io_t &io)
+{
+	app.io = &io;
+	if (!app.started)
+	{
+		app.started = true;
+		app.button_stable = in.help_button;
+		app.button_candidate = in.help_button;
+		sn2_timer_wheel_init(app.wheel, in.now_ms);
+		sn2_timer_start(app.wheel, app.telemetry_timer, in.now_ms,
+				ble_protocol_constants_t::telemetry_period_ms);
+	}
+
+	if (in.temperature_fresh)
+	{
+		/* Median first so a single spiked burst cannot raise a fault. */
+		const std::uint16_t raw =
+		    sn2_median_update(app.temperature_median, in.temperature_raw);
+		const bool fault = !sn2_temperature_in_range(app.config, raw);
+
+		if (fault && !app.sensor_fault)
+		{
+			sn2_notify_gated_event(app, io, ble_event_type_t::sensor_fault, 1,
+					       in.now_ms);
+		}
+		app.sensor_fault = fault;
+		if (!fault)
+		{
+			app.temperature_centi = sn2_calibration_apply(
+			    app.config.calibration,
+			    sn2_temperature_centi(app.config, raw));
+			sn2_update_fan_loop(app);
+		}
+	}
+
+	app.potentiometer_raw =
+	    sn2_median_update(app.potentiometer_median, in.potentiometer_raw);
+
+	sn2_update_button(app, in);
+	sn2_update_outputs(app, io);
+
+	(void)sn2_timer_wheel_run(app.wheel, in.now_ms);
+	app.io = nullptr;
+}
+
+void sn2_app_sound(sn2_app_t &app,
+		   const std::uint16_t *samples,
+		   std::size_t count,
+		   std::uint32_t now_ms,
+		   const sn2_io_t &io)
+{
+	const bool was = app.sound.state;
+
+	if (sn2_sound_process(app.sound, samples, count) && !was)
+	{
+		sn2_notify_gated_event(app, io, ble_event_type_t::sound_detected,
+				       static_cast<std::int16_t>(app.sound.level), now_ms);
+	}
+}
+
+bool sn2_control_parse(control_packet_t &pkt, const std::uint8_t *data, std::size_t size)
+{
+	return ble_unpack_control(pkt, data, size) &&
+	       (pkt.target_node_id == static_cast<std::uint8_t>(ble_node_id_t::sn2));
+}
+
+void sn2_app_apply_control(sn2_app_t &app, const control_packet_t &pkt)
+{
+	app.override_active =
+	    (pkt.command_flags &
+	     static_cast<std::uint16_t>(ble_control_flag_t::override_enable)) != 0u;
+	app.duty_override = ble_clamp_duty_per_mille(pkt.duty_override);
+	if ((pkt.command_flags &
+	     static_cast<std::uint16_t>(ble_control_flag_t::clear_help_request)) != 0u)
+	{
+		app.help_active = false;
+		sn2_timer_stop(app.wheel, app.blink_timer);
+	}
+}
+
+bool sn2_app_control(sn2_app_t &app, const std::uint8_t *data, std::size_t size)
+{
+	control_packet_t pkt{};
+	const bool ok = sn2_control_parse(pkt, data, size);
+
+	if (ok)
+	{
+		sn2_app_apply_control(app, pkt);
+	}
+
+	return ok;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file	sn2-app.hpp
+ * @brief	Platform-independent SN2 application logic
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * All SN2 behaviour (sensing, help button, fan duty, override handling,
+ * telemetry and event generation) lives here, behind a small input and
+ * output interface, so the same code runs on the Photon 2 and on the
+ * host. The firmware glue in Sensor-Node-2.cpp samples the hardware into
+ * sn2_inputs_t, calls sn2_app_step(), hands complete microphone blocks
+ * to sn2_app_sound() and forwards validated control packets to
+ * sn2_app_apply_control(); outputs leave through the sn2_io_t callbacks.
+ *
+ * The logic is a pure function of its inputs and the millisecond clock
+ * they carry, which is what makes deterministic host replay possible.
+ * Periodic and delayed work (telemetry, button debounce, LED blink) is
+ * scheduled on a timer wheel advanced to now_ms by every step, so no job
+ * blocks and none is polled.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../protocol/ble-protocol.hpp"
+#include "sn2-calibration.hpp"
+#include "sn2-median.hpp"
+#include "sn2-pi.hpp"
+#include "sn2-sound.hpp"
+#include "sn2-thermistor.hpp"
+#include "sn2-timer-wheel.hpp"
+
+/**
+ * @brief Output channels for notifications leaving the node.
+ */
+enum class sn2_channel_t : std::uint8_t
+{
+	telemetry = 1u,
+	event = 2u
+};
+
+/**
+ * @brief Hardware sample taken once per application step.
+ *
+ * On the node every sample is one scan of the acquisition layer
+ * (sn2-acquire.hpp), so all fields describe the same instant, now_ms.
+ * The thermistor is read as one oversampled burst per telemetry period:
+ * the scan takes it at or after sn2_app_temperature_deadline(), stores
+ * the decimated code (config.temperature_oversample_bits extra bits) in
+ * temperature_raw and sets temperature_fresh. Other steps leave
+ * temperature_fresh false and temperature_raw is ignored.
+ */
+struct sn2_inputs_t final
+{
+	std::uint32_t now_ms;
+	std::uint16_t temperature_raw;
+	std::uint16_t potentiometer_raw;
+	bool temperature_fresh;
+	bool help_button;
+};
+
+/**
+ * @brief Output callbacks provided by the platform glue.
+ */
+struct sn2_io_t final
+{
+	void *context;
+	void (*notify)(void *context,
+		       sn2_channel_t channel,
+		       const std::uint8_t *data,
+		       std::size_t size);
+	void (*set_fan_duty)(void *context, std::uint16_t duty_per_mille);
+	void (*set_leds)(void *context, bool help_led, bool override_led);
+};
+
+/**
+ * @brief Application tuning.
+ */
+struct sn2_config_t final
+{
+	std::uint16_t adc_max;
+	std::uint16_t sound_min_margin; /* ADC counts above the noise floor */
+	std::uint8_t sound_deviations;  /* noise-floor standard deviations */
+	std::uint8_t sound_floor_shift; /* floor follows ~2^shift quiet blocks */
+	std::uint8_t temperature_oversample_bits; /* burst of 4^bits reads */
+	std::uint32_t button_debounce_ms;
+	std::uint32_t help_blink_ms;
+
+	/*
+	 * Telemetry is evaluated every telemetry_period_ms. With
+	 * telemetry_on_change it is only sent when primary_value or
+	 * duty_commanded moved more than their deadband since the last packet
+	 * sent, when flags or secondary_value changed, or when
+	 * telemetry_heartbeat_ms passed without a packet. The duty deadband
+	 * keeps the PI loop's small corrections from defeating the scheme.
+	 */
+	bool telemetry_on_change;
+	std::uint16_t telemetry_deadband_centi;
+	std::uint16_t telemetry_deadband_duty; /* per-mille */
+	std::uint32_t telemetry_heartbeat_ms;
+
+	/*
+	 * Local fan duty: a PI loop on the temperature (sn2-pi.hpp), ticked
+	 * on every fresh reading, or the potentiometer when false. A CN
+	 * override takes precedence either way.
+	 */
+	bool fan_closed_loop;
+	sn2_pi_config_t fan_pi;
+
+	/* NTC thermistor on the low side of a divider to 3V3. */
+	const sn2_thermistor_lut_t *thermistor;
+	sn2_calibration_t calibration; /* per-board, loaded at boot */
+};
+
+/**
+ * @brief Default configuration for the SN2 hardware.
+ */
+static inline constexpr sn2_config_t sn2_default_config()
+{
+	sn2_config_t cfg{};
+
+	cfg.adc_max = 4095u;
+	cfg.sound_min_margin = 100u;
+	cfg.sound_deviations = 6u;
+	cfg.sound_floor_shift = 8u;
+	cfg.temperature_oversample_bits = 3u;
+	cfg.button_debounce_ms = 30u;
+	cfg.help_blink_ms = 250u;
+	cfg.telemetry_on_change = true;
+	cfg.telemetry_deadband_centi = 20u;
+	cfg.telemetry_deadband_duty = 20u;
+	cfg.telemetry_heartbeat_ms = 10000u;
+	cfg.fan_closed_loop = true;
+	cfg.fan_pi.setpoint_centi = 2500;
+	cfg.fan_pi.kp_q8 = 256;	/* 100 per-mille per degree */
+	cfg.fan_pi.ki_q8 = 13;	/* ~5 per-mille per degree per tick */
+	cfg.fan_pi.output_min = 0u;
+	cfg.fan_pi.output_max = ble_protocol_constants_t::duty_per_mille_max;
+	cfg.fan_pi.slew_max = 100u;
+	cfg.thermistor = &sn2_thermistor_default_lut;
+	cfg.calibration = sn2_calibration_identity();
+
+	return cfg;
+}
+
+/**
+ * @brief Per-event-type lockout bookkeeping.
+ */
+struct sn2_event_gate_t final
+{
+	std::uint32_t last_ms;
+	bool sent;
+};
+
+/**
+ * @brief Spike-rejection windows (running medians, sn2-median.hpp).
+ */
+struct sn2_app_constants_t final
+{
+	/* Readings, one per step. */
+	static constexpr std::size_t potentiometer_median = 5u;
+	/* Oversampled bursts, one per telemetry period. */
+	static constexpr std::size_t temperature_median = 3u;
+};
+
+/**
+ * @brief Application state.
+ * @note Timers point back into the struct; do not copy or move it
+ *	 after sn2_app_init().
+ */
+struct sn2_app_t final
+{
+	sn2_config_t config;
+
+	bool started;
+	sn2_timer_wheel_t wheel;
+	sn2_timer_t telemetry_timer;
+	sn2_timer_t debounce_timer;
+	sn2_timer_t blink_timer;
+
+	/* Output callbacks of the step in progress (for timer callbacks). */
+	const sn2_io_t *io;
+
+	sn2_median_t<sn2_app_constants_t::temperature_median> temperature_median;
+	std::int16_t temperature_centi;
+	bool sensor_fault;
+	sn2_sound_detector_t sound;
+	sn2_median_t<sn2_app_constants_t::potentiometer_median> potentiometer_median;
+	std::uint16_t potentiometer_raw; /* median-filtered */
+	sn2_pi_t fan_pi;
+
+	bool button_stable;
+	bool button_candidate;
+
+	bool help_active;
+	bool help_led_phase;
+	bool override_active;
+	std::uint16_t duty_override;
+	std::uint16_t duty_commanded;
+	bool outputs_valid;
+
+	sn2_event_gate_t gates[5];
+
+	/* Last telemetry packet sent (telemetry_on_change). */
+	telemetry_packet_t telemetry_sent;
+	std::uint32_t telemetry_sent_ms;
+	bool telemetry_sent_valid;
+};
+
+/**
+ * @brief Node state as telemetry reports it, with the packed frame.
+ */
+struct sn2_telemetry_snapshot_t final
+{
+	std::uint32_t timestamp_ms; /* time of the sample it reflects */
+	telemetry_packet_t packet;
+	std::uint8_t frame[sizeof(telemetry_packet_t)];
+	bool frame_valid;
+};
+
+/**
+ * @brief Initialise the application.
+ * @param app Application state.
+ * @param config Configuration to use.
+ */
+void sn2_app_init(sn2_app_t &app, const sn2_config_t &config);
+
+/**
+ * @brief Time from which a step should carry a fresh temperature burst.
+ * @param app Application state.
+ * @param now_ms Current time, returned before the first step.
+ * @return The next telemetry deadline, so each telemetry packet reports
+ *	   a burst taken in the same step.
+ */
+static inline std::uint32_t sn2_app_temperature_deadline(const sn2_app_t &app,
+							 std::uint32_t now_ms)
+{
+	return app.started ? app.telemetry_timer.expires_ms : now_ms;
+}
+
+/**
+ * @brief Whether a step at now_ms should carry a fresh temperature burst.
+ */
+static inline bool sn2_app_temperature_due(const sn2_app_t &app, std::uint32_t now_ms)
+{
+	return static_cast<std::int32_t>(now_ms - sn2_app_temperature_deadline(app, now_ms)) >= 0;
+}
+
+/**
+ * @brief Make the next step write the fan duty and LEDs even if they
+ *	  have not changed, e.g. after something else drove the fan.
+ */
+static inline void sn2_app_invalidate_outputs(sn2_app_t &app)
+{
+	app.outputs_valid = false;
+}
+
+/**
+ * @brief Run one application step on a fresh hardware sample.
+ * @param app Application state.
+ * @param in Hardware sample and current time.
+ * @param io Output callbacks.
+ */
+void sn2_app_step(sn2_app_t &app, const sn2_inputs_t &in, const sn2_io_t &io);
+
+/**
+ * @brief Run sound detection on one complete microphone block.
+ * @param app Application state.
+ * @param samples Raw ADC samples.
+ * @param count Number of samples.
+ * @param now_ms Block timestamp (millis() of its last sample).
+ * @param io Output callbacks.
+ */
+void sn2_app_sound(sn2_app_t &app,
+		   const std::uint16_t *samples,
+		   std::size_t count,
+		   std::uint32_t now_ms,
+		   const sn2_io_t &io);
+
+/**
+ * @brief Capture the current telemetry state.
+ * @param app Application state.
+ * @param now_ms Time of the step that produced the state.
+ * @param snap Snapshot, with packet packed into frame.
+ * @note Telemetry notifications are sent from the same snapshot, so a
+ *	 published copy (sn2-seqlock.hpp) always matches what was sent.
+ */
+void sn2_app_snapshot(const sn2_app_t &app,
+		      std::uint32_t now_ms,
+		      sn2_telemetry_snapshot_t &snap);
+
+/**
+ * @brief Decode and validate a control characteristic write.
+ * @param pkt Decoded packet, valid on success.
+ * @param data Written bytes.
+ * @param size Number of bytes.
+ * @return true if the write is a valid command for SN2, otherwise false.
+ * @note Touches no application state, so it may run on the BLE thread.
+ */
+bool sn2_control_parse(control_packet_t &pkt, const std::uint8_t *data, std::size_t size);
+
+/**
+ * @brief Apply a validated control packet.
+ * @param app Application state.
+ * @param pkt Packet accepted by sn2_control_parse().
+ */
+void sn2_app_apply_control(sn2_app_t &app, const control_packet_t &pkt);
+
+/**
+ * @brief Apply a control characteristic write (parse, then apply).
+ * @param app Application state.
+ * @param data Written bytes.
+ * @param size Number of bytes.
+ * @return true if the write was a valid command for SN2, otherwise false.
+ */
+bool sn2_app_control(sn2_app_t &app, const std::uint8_t *data, std::size_t size);
+
+/**
+ * @brief Convert a thermistor ADC reading to centi-degrees Celsius.
+ * @param config Thermistor table, ADC range and oversampling.
+ * @param raw Oversampled ADC code (temperature_oversample_bits extra bits).
+ * @return Temperature in centi-degrees Celsius, 0 for out-of-range codes.
+ */
+std::int16_t sn2_temperature_centi(const sn2_config_t &config, std::uint16_t raw);
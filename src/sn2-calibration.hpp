@@ -0,0 +1,152 @@
+/**
+ * @file	sn2-calibration.hpp
+ * @brief	Per-board temperature calibration record and correction
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Each board's temperature reading is corrected by a polynomial of
+ * degree <= 3 fitted against a reference thermometer (host/cal/). With
+ * u = centi / 2^15,
+ *
+ *   corrected = c0 + c1 u + c2 u^2 + c3 u^3
+ *
+ * where every c_k is in centi-degrees with 15 fraction bits; the
+ * identity is c1 = 2^30. sn2_calibration_apply() evaluates it in Horner
+ * form with 64-bit intermediates and no floating point.
+ *
+ * The coefficients persist in EEPROM emulation as a 24-byte
+ * little-endian record (magic, version, degree, four coefficients,
+ * CRC-32). The record is validated once at boot; an erased, truncated or
+ * corrupted record is rejected and the identity is used instead.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../protocol/ble-protocol.hpp"
+
+/**
+ * @brief Calibration record constants.
+ */
+struct sn2_calibration_constants_t final
+{
+	static constexpr std::uint16_t magic = 0x4C43u; /* "CL" */
+	static constexpr std::uint8_t version = 1u;
+	static constexpr std::size_t max_degree = 3u;
+	static constexpr int coeff_shift = 15;
+	static constexpr std::int32_t identity_c1 = static_cast<std::int32_t>(1) << 30;
+	static constexpr std::size_t record_size = 24u;
+	static constexpr std::size_t crc_offset = 20u;
+};
+
+/**
+ * @brief Correction polynomial.
+ */
+struct sn2_calibration_t final
+{
+	std::int32_t coeff[sn2_calibration_constants_t::max_degree + 1u];
+	std::uint8_t degree;
+};
+
+/**
+ * @brief Calibration that leaves readings unchanged.
+ */
+static inline constexpr sn2_calibration_t sn2_calibration_identity()
+{
+	return sn2_calibration_t{{0, sn2_calibration_constants_t::identity_c1, 0, 0}, 1u};
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3, reflected) of a byte range.
+ */
+static inline std::uint32_t sn2_crc32(const std::uint8_t *data, std::size_t size)
+{
+	std::uint32_t crc = 0xFFFFFFFFu;
+
+	for (std::size_t i = 0u; i < size; ++i)
+	{
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; ++bit)
+		{
+			crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+		}
+	}
+
+	return ~crc;
+}
+
+/**
+ * @brief Serialise a calibration into its persistent record.
+ * @param dst Destination, at least record_size bytes.
+ * @param cal Calibration.
+ */
+static inline void sn2_calibration_pack(std::uint8_t *dst, const sn2_calibration_t &cal)
+{
+	ble_store_le<std::uint16_t>(dst, sn2_calibration_constants_t::magic);
+	dst[2] = sn2_calibration_constants_t::version;
+	dst[3] = cal.degree;
+	for (std::size_t k = 0u; k <= sn2_calibration_constants_t::max_degree; ++k)
+	{
+		ble_store_le<std::int32_t>(dst + 4u + (k * 4u), cal.coeff[k]);
+	}
+	ble_store_le<std::uint32_t>(dst + sn2_calibration_constants_t::crc_offset,
+				    sn2_crc32(dst, sn2_calibration_constants_t::crc_offset));
+}
+
+/**
+ * @brief Validate and decode a persistent record.
+ * @param src Record bytes.
+ * @param size Number of bytes available.
+ * @param cal Decoded calibration, written only on success.
+ * @return true if the record is complete, current and intact.
+ */
+static inline bool sn2_calibration_unpack(const std::uint8_t *src,
+					  std::size_t size,
+					  sn2_calibration_t &cal)
+{
+	bool ok = (src != nullptr) && (size >= sn2_calibration_constants_t::record_size);
+
+	ok = ok && (ble_load_le<std::uint16_t>(src) == sn2_calibration_constants_t::magic) &&
+	     (src[2] == sn2_calibration_constants_t::version) &&
+	     (src[3] <= sn2_calibration_constants_t::max_degree) &&
+	     (ble_load_le<std::uint32_t>(src + sn2_calibration_constants_t::crc_offset) ==
+	      sn2_crc32(src, sn2_calibration_constants_t::crc_offset));
+
+	if (ok)
+	{
+		cal.degree = src[3];
+		for (std::size_t k = 0u; k <= sn2_calibration_constants_t::max_degree; ++k)
+		{
+			cal.coeff[k] = ble_load_le<std::int32_t>(src + 4u + (k * 4u));
+		}
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Correct a centi-degree reading.
+ * @param cal Calibration.
+ * @param centi Uncorrected temperature in centi-degrees Celsius.
+ * @return Corrected temperature, saturated to the int16 range.
+ */
+static inline std::int16_t sn2_calibration_apply(const sn2_calibration_t &cal,
+						 std::int16_t centi)
+{
+	constexpr int shift = sn2_calibration_constants_t::coeff_shift;
+	std::int64_t acc = cal.coeff[cal.degree];
+
+	for (std::size_t k = cal.degree; k > 0u; --k)
+	{
+		acc = ((acc * centi) >> shift) + cal.coeff[k - 1u];
+	}
+	acc = (acc + (static_cast<std::int64_t>(1) << (shift - 1))) >> shift;
+
+	return (acc > 32767)	? static_cast<std::int16_t>(32767)
+	       : (acc < -32768) ? static_cast<std::int16_t>(-32768)
+				: static_cast<std::int16_t>(acc);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file	sn2-cx-math.hpp
+ * @brief	Elementary functions for constant expressions
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * <cmath> is not constexpr in C++17, so tables and coefficients that
+ * are generated at compile time (filter designs, the thermistor table)
+ * use these series instead. They are accurate to double precision over
+ * the documented ranges and are never meant to run on the device.
+ */
+
+#pragma once
+
+/**
+ * @brief Mathematical constants.
+ */
+struct sn2_cx_constants_t final
+{
+	static constexpr double pi = 3.14159265358979323846;
+	static constexpr double ln2 = 0.69314718055994530942;
+};
+
+/**
+ * @brief Taylor-series sine, |x| <= pi.
+ */
+static inline constexpr double sn2_cx_sin(double x)
+{
+	double term = x;
+	double sum = x;
+
+	for (int n = 1; n < 14; ++n)
+	{
+		term *= -(x * x) / static_cast<double>((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Taylor-series cosine, |x| <= pi.
+ */
+static inline constexpr double sn2_cx_cos(double x)
+{
+	double term = 1.0;
+	double sum = 1.0;
+
+	for (int n = 1; n < 14; ++n)
+	{
+		term *= -(x * x) / static_cast<double>((2 * n - 1) * (2 * n));
+		sum += term;
+	}
+
+	return sum;
+}
+
+/**
+ * @brief exp(x), reduced by halving and squared back.
+ */
+static inline constexpr double sn2_cx_exp(double x)
+{
+	int halvings = 0;
+	double term = 1.0;
+	double sum = 1.0;
+
+	while ((x > 0.5) || (x < -0.5))
+	{
+		x *= 0.5;
+		++halvings;
+	}
+	for (int n = 1; n < 16; ++n)
+	{
+		term *= x / static_cast<double>(n);
+		sum += term;
+	}
+	for (; halvings > 0; --halvings)
+	{
+		sum *= sum;
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Natural logarithm, x > 0.
+ *
+ * x = m 2^k with m in [0.75, 1.5), then ln(m) = 2 atanh((m - 1) / (m + 1)).
+ */
+static inline constexpr double sn2_cx_log(double x)
+{
+	int k = 0;
+
+	while (x >= 1.5)
+	{
+		x *= 0.5;
+		++k;
+	}
+	while (x < 0.75)
+	{
+		x *= 2.0;
+		--k;
+	}
+
+	const double z = (x - 1.0) / (x + 1.0);
+	double term = z;
+	double sum = 0.0;
+
+	for (int n = 1; n < 40; n += 2)
+	{
+		sum += term / static_cast<double>(n);
+		term *= z * z;
+	}
+
+	return (2.0 * sum) + (static_cast<double>(k) * sn2_cx_constants_t::ln2);
+}
@@ -0,0 +1,310 @@
+/**
+ * @file	sn2-filter.hpp
+ * @brief	Fixed-point biquad cascade and envelope follower
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Integer-only block filters for the sound channel:
+ *
+ * - Biquad sections in direct form I on Q15 samples. Coefficients are
+ *   Q2.14 (range [-2, 2)) so a1 of a low-frequency section fits, and the
+ *   five products are accumulated in 64 bits before rounding and
+ *   saturating back to Q15 (one SMLAL each on the Cortex-M33).
+ * - An attack/release envelope follower on the rectified Q15 signal
+ *   whose state is Q31, so slow release constants keep full precision.
+ *
+ * Coefficients are designed in constexpr functions (RBJ cookbook
+ * low-pass, high-pass and band-pass; one-pole attack/release constants,
+ * using sn2-cx-math.hpp) and quantised at compile time. Doubles only
+ * appear in those constant expressions; nothing here evaluates floating
+ * point at run time.
+ *
+ * Blocks are processed one section at a time so each section's state
+ * stays in registers for the whole block. Input and output may alias.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sn2-cx-math.hpp"
+
+/**
+ * @brief Filter designs supported by sn2_biquad_design_q15().
+ */
+enum class sn2_biquad_type_t : std::uint8_t
+{
+	lowpass = 0u,
+	highpass = 1u,
+	bandpass = 2u /* constant 0 dB peak gain */
+};
+
+/**
+ * @brief One biquad section, Q2.14 coefficients normalised by a0.
+ *
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+struct sn2_biquad_q15_t final
+{
+	std::int16_t b0;
+	std::int16_t b1;
+	std::int16_t b2;
+	std::int16_t a1;
+	std::int16_t a2;
+};
+
+/**
+ * @brief Direct form I state of one section (Q15).
+ */
+struct sn2_biquad_state_q15_t final
+{
+	std::int16_t x1;
+	std::int16_t x2;
+	std::int16_t y1;
+	std::int16_t y2;
+};
+
+/**
+ * @brief Cascade of Sections biquads with its state.
+ */
+template <std::size_t Sections>
+struct sn2_biquad_cascade_q15_t final
+{
+	static_assert(Sections >= 1u, "cascade needs at least one section");
+
+	sn2_biquad_q15_t coeffs[Sections];
+	sn2_biquad_state_q15_t state[Sections];
+};
+
+/**
+ * @brief Attack/release envelope follower.
+ */
+struct sn2_envelope_q31_t final
+{
+	std::int16_t attack;  /* Q15 smoothing factor while rising */
+	std::int16_t release; /* Q15 smoothing factor while falling */
+	std::int32_t level;   /* Q31 envelope of |x| */
+};
+
+/* ------------------------------------------------------------------ */
+/* Compile-time design                                                */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Fixed-point format constants.
+ */
+struct sn2_filter_constants_t final
+{
+	static constexpr int coeff_shift = 14;
+	static constexpr int envelope_shift = 16; /* Q15 -> Q31 */
+};
+
+/**
+ * @brief Round and saturate a real value to a fixed-point int16.
+ * @param v Value.
+ * @param shift Fraction bits.
+ * @note Saturates to +/-32767 so negating a coefficient never overflows.
+ */
+static inline constexpr std::int16_t sn2_filter_quantise(double v, int shift)
+{
+	const double scaled = v * static_cast<double>(1L << shift);
+	const double rounded = (scaled >= 0.0) ? (scaled + 0.5) : (scaled - 0.5);
+
+	return (rounded >= 32767.0)	 ? static_cast<std::int16_t>(32767)
+	       : (rounded <= -32767.0) ? static_cast<std::int16_t>(-32767)
+				       : static_cast<std::int16_t>(rounded);
+}
+
+/**
+ * @brief Design one quantised biquad section (RBJ audio EQ cookbook).
+ * @param type Response.
+ * @param f0_hz Corner (low/high-pass) or centre (band-pass) frequency.
+ * @param q Quality factor (0.7071 for Butterworth sections).
+ * @param fs_hz Sample rate.
+ */
+static inline constexpr sn2_biquad_q15_t sn2_biquad_design_q15(sn2_biquad_type_t type,
+							       double f0_hz,
+							       double q,
+							       double fs_hz)
+{
+	const double w0 = (2.0 * sn2_cx_constants_t::pi * f0_hz) / fs_hz;
+	const double cw = sn2_cx_cos(w0);
+	const double alpha = sn2_cx_sin(w0) / (2.0 * q);
+	const double a0 = 1.0 + alpha;
+	double b0 = alpha;
+	double b1 = 0.0;
+	double b2 = -alpha;
+
+	if (type == sn2_biquad_type_t::lowpass)
+	{
+		b0 = (1.0 - cw) / 2.0;
+		b1 = 1.0 - cw;
+		b2 = b0;
+	}
+	else if (type == sn2_biquad_type_t::highpass)
+	{
+		b0 = (1.0 + cw) / 2.0;
+		b1 = -(1.0 + cw);
+		b2 = b0;
+	}
+
+	const int shift = sn2_filter_constants_t::coeff_shift;
+
+	return sn2_biquad_q15_t{sn2_filter_quantise(b0 / a0, shift),
+				sn2_filter_quantise(b1 / a0, shift),
+				sn2_filter_quantise(b2 / a0, shift),
+				sn2_filter_quantise((-2.0 * cw) / a0, shift),
+				sn2_filter_quantise((1.0 - alpha) / a0, shift)};
+}
+
+/**
+ * @brief Q15 one-pole smoothing factor for a time constant.
+ * @param tau_ms Time constant in milliseconds.
+ * @param fs_hz Sample rate.
+ * @return 1 - exp(-1 / (tau * fs)) in Q15.
+ */
+static inline constexpr std::int16_t sn2_envelope_coeff_q15(double tau_ms, double fs_hz)
+{
+	return sn2_filter_quantise(1.0 - sn2_cx_exp(-1000.0 / (tau_ms * fs_hz)), 15);
+}
+
+/* ------------------------------------------------------------------ */
+/* Run time                                                           */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Saturate to the Q15 range.
+ */
+static inline std::int16_t sn2_sat_q15(std::int64_t v)
+{
+	return (v > 32767)    ? static_cast<std::int16_t>(32767)
+	       : (v < -32768) ? static_cast<std::int16_t>(-32768)
+			      : static_cast<std::int16_t>(v);
+}
+
+/**
+ * @brief Advance one section by one sample.
+ * @return Output sample.
+ */
+static inline std::int16_t sn2_biquad_q15_step(const sn2_biquad_q15_t &c,
+					       sn2_biquad_state_q15_t &s,
+					       std::int16_t x)
+{
+	const std::int64_t acc = static_cast<std::int64_t>(c.b0 * x) + (c.b1 * s.x1) +
+				 (c.b2 * s.x2) - (c.a1 * s.y1) - (c.a2 * s.y2);
+	const std::int16_t y = sn2_sat_q15(
+	    (acc + (1 << (sn2_filter_constants_t::coeff_shift - 1))) >>
+	    sn2_filter_constants_t::coeff_shift);
+
+	s.x2 = s.x1;
+	s.x1 = x;
+	s.y2 = s.y1;
+	s.y1 = y;
+
+	return y;
+}
+
+/**
+ * @brief Run one section over a block.
+ * @param c Coefficients.
+ * @param state Section state.
+ * @param in Input samples.
+ * @param out Output samples (may equal in).
+ * @param count Number of samples.
+ */
+static inline void sn2_biquad_q15_block(const sn2_biquad_q15_t &c,
+					sn2_biquad_state_q15_t &state,
+					const std::int16_t *in,
+					std::int16_t *out,
+					std::size_t count)
+{
+	sn2_biquad_state_q15_t s = state;
+
+	for (std::size_t n = 0u; n < count; ++n)
+	{
+		out[n] = sn2_biquad_q15_step(c, s, in[n]);
+	}
+	state = s;
+}
+
+/**
+ * @brief Load coefficients and clear the state of a cascade.
+ */
+template <std::size_t Sections>
+static inline void sn2_biquad_cascade_init(sn2_biquad_cascade_q15_t<Sections> &cascade,
+					   const sn2_biquad_q15_t (&coeffs)[Sections])
+{
+	for (std::size_t i = 0u; i < Sections; ++i)
+	{
+		cascade.coeffs[i] = coeffs[i];
+		cascade.state[i] = sn2_biquad_state_q15_t{0, 0, 0, 0};
+	}
+}
+
+/**
+ * @brief Filter a block through every section of a cascade.
+ * @param cascade Cascade.
+ * @param in Input samples.
+ * @param out Output samples (may equal in).
+ * @param count Number of samples.
+ */
+template <std::size_t Sections>
+static inline void sn2_biquad_cascade_process(sn2_biquad_cascade_q15_t<Sections> &cascade,
+					      const std::int16_t *in,
+					      std::int16_t *out,
+					      std::size_t count)
+{
+	sn2_biquad_q15_block(cascade.coeffs[0], cascade.state[0], in, out, count);
+	for (std::size_t i = 1u; i < Sections; ++i)
+	{
+		sn2_biquad_q15_block(cascade.coeffs[i], cascade.state[i], out, out, count);
+	}
+}
+
+/**
+ * @brief Initialise an envelope follower at zero.
+ * @param env Follower.
+ * @param attack Q15 factor while rising (sn2_envelope_coeff_q15()).
+ * @param release Q15 factor while falling.
+ */
+static inline void sn2_envelope_init(sn2_envelope_q31_t &env,
+				     std::int16_t attack,
+				     std::int16_t release)
+{
+	env.attack = attack;
+	env.release = release;
+	env.level = 0;
+}
+
+/**
+ * @brief Track the envelope of a block.
+ * @param env Follower.
+ * @param x Q15 samples.
+ * @param count Number of samples.
+ * @return Peak Q31 envelope over the block.
+ */
+static inline std::int32_t sn2_envelope_process(sn2_envelope_q31_t &env,
+						const std::int16_t *x,
+						std::size_t count)
+{
+	std::int32_t level = env.level;
+	std::int32_t peak = level;
+
+	for (std::size_t n = 0u; n < count; ++n)
+	{
+		/* |-32768| saturates to 32767 so the target stays below 2^31. */
+		const std::int32_t mag = (x[n] < 0) ? ((x[n] == -32768) ? 32767 : -x[n]) : x[n];
+		const std::int32_t target = mag << sn2_filter_constants_t::envelope_shift;
+		const std::int32_t delta = target - level;
+		const std::int32_t k = (delta > 0) ? env.attack : env.release;
+
+		level += static_cast<std::int32_t>((static_cast<std::int64_t>(delta) * k) >> 15);
+		peak = (level > peak) ? level : peak;
+	}
+	env.level = level;
+
+	return peak;
+}
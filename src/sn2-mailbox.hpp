@@ -0,0 +1,124 @@
+/**
+ * @file	sn2-mailbox.hpp
+ * @brief	Wait-free overwrite-latest mailbox between two threads
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Carries values of T from one producer to one consumer when only the
+ * most recent value matters, e.g. control packets from the BLE write
+ * handler (system thread) to loop() (application thread).
+ *
+ * It is a triple buffer: the producer owns one slot, the consumer owns
+ * one, and the third is exchanged between them through a single atomic
+ * byte holding its index and a "fresh" bit. sn2_mailbox_post() writes
+ * its slot and swaps it in; sn2_mailbox_take() swaps the fresh slot out
+ * when there is one. Each side is a fixed number of instructions with no
+ * lock and no retry loop, so a post can never block behind loop() (no
+ * priority inversion against the radio stack), and the consumer always
+ * gets the latest complete value.
+ *
+ * A post that replaces a value the consumer has not taken yet counts
+ * one drop in drops.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Mailbox encoding constants.
+ */
+struct sn2_mailbox_constants_t final
+{
+	static constexpr std::uint8_t index_mask = 0x03u;
+	static constexpr std::uint8_t fresh = 0x04u;
+};
+
+/**
+ * @brief Single-producer/single-consumer latest-value mailbox.
+ * @tparam T Trivially copyable value type.
+ */
+template <typename T>
+struct sn2_mailbox_t final
+{
+	T slots[3];
+	std::uint8_t back;  /* producer's slot */
+	std::uint8_t front; /* consumer's slot */
+
+	/* Slot in between, ORed with fresh if it holds an untaken value. */
+	std::atomic<std::uint8_t> middle;
+	std::atomic<std::uint32_t> drops;
+};
+
+/**
+ * @brief Reset a mailbox to empty.
+ */
+template <typename T>
+static inline void sn2_mailbox_init(sn2_mailbox_t<T> &mb)
+{
+	mb.back = 0u;
+	mb.front = 1u;
+	mb.middle.store(2u, std::memory_order_relaxed);
+	mb.drops.store(0u, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Producer: publish a value, replacing any untaken one.
+ * @param mb Mailbox.
+ * @param value Value to publish.
+ * @return false if an untaken value was overwritten (counted in drops).
+ */
+template <typename T>
+static inline bool sn2_mailbox_post(sn2_mailbox_t<T> &mb, const T &value)
+{
+	mb.slots[mb.back] = value;
+
+	const std::uint8_t prev = mb.middle.exchange(
+	    static_cast<std::uint8_t>(mb.back | sn2_mailbox_constants_t::fresh),
+	    std::memory_order_acq_rel);
+	const bool dropped = (prev & sn2_mailbox_constants_t::fresh) != 0u;
+
+	mb.back = prev & sn2_mailbox_constants_t::index_mask;
+	if (dropped)
+	{
+		mb.drops.fetch_add(1u, std::memory_order_relaxed);
+	}
+
+	return !dropped;
+}
+
+/**
+ * @brief Consumer: take the latest value, if one was posted since the
+ *	  last take.
+ * @param mb Mailbox.
+ * @param value Set to the value on success.
+ * @return true if a value was taken, otherwise false.
+ */
+template <typename T>
+static inline bool sn2_mailbox_take(sn2_mailbox_t<T> &mb, T &value)
+{
+	/* Only the consumer clears fresh, so a fresh slot stays fresh. */
+	const bool ok =
+	    (mb.middle.load(std::memory_order_relaxed) & sn2_mailbox_constants_t::fresh) != 0u;
+
+	if (ok)
+	{
+		mb.front = mb.middle.exchange(mb.front, std::memory_order_acq_rel) &
+			   sn2_mailbox_constants_t::index_mask;
+		value = mb.slots[mb.front];
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Values overwritten before the consumer took them.
+ */
+template <typename T>
+static inline std::uint32_t sn2_mailbox_drops(const sn2_mailbox_t<T> &mb)
+{
+	return mb.drops.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,228 @@
+/**
+ * @file	sn2-median.hpp
+ * @brief	Sorting-network median filter for slow ADC channels
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * A running median over the last N readings removes single-sample spikes
+ * (and any burst shorter than N / 2 + 1 readings) without smearing steps
+ * the way an average does.
+ *
+ * The median is selected by a comparator network built in a constant
+ * expression for each window size: Batcher's odd-even merge sort for N
+ * wires, pruned backwards from the middle wire so only comparators that
+ * can affect the median remain, and comparators with one live output
+ * reduced to a single min or max. Each comparator is unrolled into
+ * (a < b) ? a : b selects with no data-dependent branches, so the cost
+ * is fixed per reading: 3, 8, 14 and 24 comparators for N = 3, 5, 7, 9.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief Median network limits.
+ */
+struct sn2_median_constants_t final
+{
+	static constexpr std::size_t max_window = 9u;
+	/* Batcher's network for 16 wires has 63 comparators. */
+	static constexpr std::size_t max_comparators = 64u;
+};
+
+/**
+ * @brief Outputs a comparator has to produce.
+ */
+enum class sn2_median_keep_t : std::uint8_t
+{
+	both = 0u,     /* lo <- min, hi <- max */
+	min_only = 1u, /* lo <- min, hi unused afterwards */
+	max_only = 2u  /* hi <- max, lo unused afterwards */
+};
+
+/**
+ * @brief Comparator network selecting the median of count wires.
+ */
+struct sn2_median_network_t final
+{
+	std::uint8_t lo[sn2_median_constants_t::max_comparators];
+	std::uint8_t hi[sn2_median_constants_t::max_comparators];
+	sn2_median_keep_t keep[sn2_median_constants_t::max_comparators];
+	std::size_t count;
+};
+
+/**
+ * @brief Build the pruned median network for n wires.
+ * @param n Odd window size, 3 to max_window.
+ */
+static inline constexpr sn2_median_network_t sn2_median_network(std::size_t n)
+{
+	sn2_median_network_t sort{};
+	sn2_median_network_t net{};
+	bool live[sn2_median_constants_t::max_window] = {};
+
+	/* Batcher odd-even merge sort, wires at or above n treated as +inf. */
+	for (std::size_t p = 1u; p < n; p <<= 1)
+	{
+		for (std::size_t k = p; k >= 1u; k >>= 1)
+		{
+			for (std::size_t j = k % p; (j + k) < n; j += 2u * k)
+			{
+				for (std::size_t i = 0u; (i < k) && ((i + j + k) < n); ++i)
+				{
+					if (((i + j) / (2u * p)) == ((i + j + k) / (2u * p)))
+					{
+						sort.lo[sort.count] = static_cast<std::uint8_t>(i + j);
+						sort.hi[sort.count] = static_cast<std::uint8_t>(i + j + k);
+						++sort.count;
+					}
+				}
+			}
+		}
+	}
+
+	/* Walk backwards from the median wire, dropping dead comparators. */
+	live[n / 2u] = true;
+	for (std::size_t c = sort.count; c > 0u; --c)
+	{
+		const std::uint8_t lo = sort.lo[c - 1u];
+		const std::uint8_t hi = sort.hi[c - 1u];
+
+		if (live[lo] || live[hi])
+		{
+			net.keep[net.count] = !live[hi]   ? sn2_median_keep_t::min_only
+					      : !live[lo] ? sn2_median_keep_t::max_only
+							  : sn2_median_keep_t::both;
+			net.lo[net.count] = lo;
+			net.hi[net.count] = hi;
+			live[lo] = true;
+			live[hi] = true;
+			++net.count;
+		}
+	}
+
+	/* Collected in reverse; restore execution order. */
+	for (std::size_t c = 0u; c < (net.count / 2u); ++c)
+	{
+		const std::size_t d = net.count - 1u - c;
+		const std::uint8_t lo = net.lo[c];
+		const std::uint8_t hi = net.hi[c];
+		const sn2_median_keep_t keep = net.keep[c];
+
+		net.lo[c] = net.lo[d];
+		net.hi[c] = net.hi[d];
+		net.keep[c] = net.keep[d];
+		net.lo[d] = lo;
+		net.hi[d] = hi;
+		net.keep[d] = keep;
+	}
+
+	return net;
+}
+
+/**
+ * @brief Network for window size N, built at compile time.
+ */
+template <std::size_t N>
+inline constexpr sn2_median_network_t sn2_median_network_v = sn2_median_network(N);
+
+/**
+ * @brief Apply comparator C of the N-wire network.
+ */
+template <std::size_t N, std::size_t C, typename T>
+static inline void sn2_median_compare(T (&v)[N])
+{
+	constexpr std::size_t lo = sn2_median_network_v<N>.lo[C];
+	constexpr std::size_t hi = sn2_median_network_v<N>.hi[C];
+	constexpr sn2_median_keep_t keep = sn2_median_network_v<N>.keep[C];
+	const T a = v[lo];
+	const T b = v[hi];
+
+	if constexpr (keep != sn2_median_keep_t::max_only)
+	{
+		v[lo] = (b < a) ? b : a;
+	}
+	if constexpr (keep != sn2_median_keep_t::min_only)
+	{
+		v[hi] = (b < a) ? a : b;
+	}
+}
+
+template <std::size_t N, typename T, std::size_t... C>
+static inline void sn2_median_run(T (&v)[N], std::index_sequence<C...>)
+{
+	(sn2_median_compare<N, C>(v), ...);
+}
+
+/**
+ * @brief Median of N values.
+ * @param v Values; reordered in place.
+ * @return The median (v[N / 2] after the network).
+ */
+template <std::size_t N, typename T>
+static inline T sn2_median_select(T (&v)[N])
+{
+	static_assert(((N % 2u) == 1u) && (N >= 3u) && (N <= sn2_median_constants_t::max_window),
+		      "median window must be odd, 3 to 9");
+	static_assert(sn2_median_network_v<N>.count <= sn2_median_constants_t::max_comparators,
+		      "median network too large");
+
+	sn2_median_run(v, std::make_index_sequence<sn2_median_network_v<N>.count>{});
+
+	return v[N / 2u];
+}
+
+/**
+ * @brief Running median over the last N readings of one ADC channel.
+ */
+template <std::size_t N>
+struct sn2_median_t final
+{
+	std::uint16_t window[N];
+	std::uint8_t next;
+	bool primed;
+};
+
+/**
+ * @brief Clear a running median; the next reading fills the window.
+ */
+template <std::size_t N>
+static inline void sn2_median_init(sn2_median_t<N> &m)
+{
+	m = sn2_median_t<N>{};
+}
+
+/**
+ * @brief Add a reading and return the median of the window.
+ * @param m Running median.
+ * @param x New reading.
+ * @return Median of the last N readings (the first reading fills the
+ *	   whole window, so there is no start-up transient).
+ */
+template <std::size_t N>
+static inline std::uint16_t sn2_median_update(sn2_median_t<N> &m, std::uint16_t x)
+{
+	std::uint16_t v[N];
+
+	if (!m.primed)
+	{
+		for (std::uint16_t &w : m.window)
+		{
+			w = x;
+		}
+		m.primed = true;
+	}
+	m.window[m.next] = x;
+	m.next = static_cast<std::uint8_t>(((m.next + 1u) == N) ? 0u : (m.next + 1u));
+	for (std::size_t i = 0u; i < N; ++i)
+	{
+		v[i] = m.window[i];
+	}
+
+	return sn2_median_select(v);
+}
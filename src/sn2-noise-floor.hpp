@@ -0,0 +1,135 @@
+/**
+ * @file	sn2-noise-floor.hpp
+ * @brief	Streaming fixed-point noise-floor estimator
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Tracks the exponentially weighted mean and variance of a stream of
+ * non-negative levels in O(1) integer operations per observation:
+ *
+ *   d     = x - mean
+ *   mean += d / 2^shift
+ *   var  += (d^2 - var) / 2^shift
+ *
+ * mean carries frac_bits fraction bits so small weights still move it;
+ * var is kept in the same fixed-point units squared. An observation is
+ * an outlier when it exceeds the mean by more than k standard
+ * deviations, tested as excess^2 > k^2 var so no square root is taken.
+ *
+ * The caller decides which observations feed the estimator. The sound
+ * detector feeds it quiet blocks; while sound is present it only lets
+ * the mean drift towards the level at a much smaller weight
+ * (sn2_noise_floor_drift()). A long event thus barely raises its own
+ * floor, but a lasting rise in ambient noise is eventually learnt and
+ * cannot latch detection on. The variance is left alone there: the
+ * event's large deviations would inflate it within seconds.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief EWMA mean/variance state.
+ */
+struct sn2_noise_floor_t final
+{
+	std::int64_t var;   /* (mean units)^2 */
+	std::int32_t mean;  /* input units << frac_bits */
+	std::uint8_t shift; /* weight 2^-shift, time constant ~2^shift updates */
+	bool primed;
+};
+
+/**
+ * @brief Noise-floor fixed-point constants.
+ */
+struct sn2_noise_floor_constants_t final
+{
+	static constexpr int frac_bits = 8;
+};
+
+/**
+ * @brief Initialise an estimator with no observations.
+ * @param floor Estimator.
+ * @param shift EWMA weight exponent.
+ */
+static inline void sn2_noise_floor_init(sn2_noise_floor_t &floor, std::uint8_t shift)
+{
+	floor.var = 0;
+	floor.mean = 0;
+	floor.shift = shift;
+	floor.primed = false;
+}
+
+/**
+ * @brief Add one observation.
+ * @param floor Estimator.
+ * @param x Level, at most 2^(31 - frac_bits) - 1.
+ * @note The first observation seeds the mean.
+ */
+static inline void sn2_noise_floor_update(sn2_noise_floor_t &floor, std::int32_t x)
+{
+	const std::int32_t scaled = x * (1 << sn2_noise_floor_constants_t::frac_bits);
+
+	if (!floor.primed)
+	{
+		floor.mean = scaled;
+		floor.var = 0;
+		floor.primed = true;
+	}
+	else
+	{
+		const std::int32_t d = scaled - floor.mean;
+		const std::int64_t d2 = static_cast<std::int64_t>(d) * d;
+
+		floor.mean += d / (1 << floor.shift);
+		floor.var += (d2 - floor.var) / (static_cast<std::int64_t>(1) << floor.shift);
+	}
+}
+
+/**
+ * @brief Move only the mean towards an observation, at weight
+ *	  2^-(shift + extra_shift).
+ * @param floor Primed estimator.
+ * @param x Level, at most 2^(31 - frac_bits) - 1.
+ * @param extra_shift Further weight exponent.
+ */
+static inline void sn2_noise_floor_drift(sn2_noise_floor_t &floor,
+					 std::int32_t x,
+					 std::uint8_t extra_shift)
+{
+	const std::int32_t d = x * (1 << sn2_noise_floor_constants_t::frac_bits) - floor.mean;
+
+	floor.mean += d / (1 << (floor.shift + extra_shift));
+}
+
+/**
+ * @brief Current mean in input units.
+ */
+static inline std::int32_t sn2_noise_floor_mean(const sn2_noise_floor_t &floor)
+{
+	return floor.mean / (1 << sn2_noise_floor_constants_t::frac_bits);
+}
+
+/**
+ * @brief Test whether a level stands out from the floor.
+ * @param floor Estimator.
+ * @param x Level.
+ * @param deviations k, in standard deviations.
+ * @param min_margin Excess (input units) required however quiet the floor.
+ * @return true if x > mean + max(k sigma, min_margin).
+ */
+static inline bool sn2_noise_floor_exceeds(const sn2_noise_floor_t &floor,
+					   std::int32_t x,
+					   std::uint8_t deviations,
+					   std::int32_t min_margin)
+{
+	const std::int32_t excess = x - sn2_noise_floor_mean(floor);
+	const std::int64_t scaled = static_cast<std::int64_t>(excess) *
+				    (1 << sn2_noise_floor_constants_t::frac_bits);
+	const std::int64_t k = deviations;
+
+	return (excess > min_margin) && ((scaled * scaled) > ((k * k) * floor.var));
+}
@@ -0,0 +1,199 @@
+/**
+ * @file	sn2-override.hpp
+ * @brief	Immediate fan override from the control write handler
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * A control write with override_enable set should move the fan at once,
+ * not when loop() next applies the packet. The write handler therefore
+ * clamps duty_override and writes the PWM itself
+ * (sn2_override_fast_apply()), after posting the packet to the control
+ * mailbox as usual. The application still applies the packet on its
+ * own thread and ends up commanding the same duty, so the two paths
+ * agree once loop() catches up.
+ *
+ * Until then, the application's fan writes are based on older state and
+ * must not undo the override. The handler counts its PWM writes in
+ * posted. Before taking the mailbox, loop() records that count
+ * (sn2_override_fast_mark()), and after applying the packet it marks the
+ * count as synced (sn2_override_fast_sync()). The application's writes
+ * go through sn2_override_fast_app_write(), which:
+ *
+ * - drops the write while a newer fast write is outstanding, and
+ * - restores the fast duty if a fast write landed during its own write.
+ *
+ * The application caches the duty it last commanded and only writes on
+ * a change, so neither a dropped write nor a fast write that a later
+ * packet superseded in the mailbox (enable, then disable, before loop()
+ * runs) would ever be corrected. sn2_override_fast_sync() therefore
+ * reports when either happened since the last sync, and loop() then
+ * makes the application rewrite its duty (sn2_app_invalidate_outputs()).
+ *
+ * The PWM is reached through sn2_pwm_port_t: analogWrite() on the node,
+ * the shim's recorded PWM in native builds.
+ *
+ * Each fast write's latency, from handler entry to PWM update, is
+ * accumulated on the handler thread and published through a seqlock
+ * (sn2-seqlock.hpp) for readers on any thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "../protocol/ble-protocol.hpp"
+#include "sn2-seqlock.hpp"
+
+/**
+ * @brief Fan PWM output.
+ */
+struct sn2_pwm_port_t final
+{
+	void *context;
+	void (*write)(void *context, std::uint16_t duty_per_mille);
+};
+
+/**
+ * @brief Write-to-PWM latency of the fast path, in microseconds.
+ */
+struct sn2_override_latency_t final
+{
+	std::uint64_t total_us;
+	std::uint32_t count;
+	std::uint32_t last_us;
+	std::uint32_t max_us;
+	std::uint32_t reserved;
+};
+
+/**
+ * @brief Fast override state shared by the write handler and loop().
+ */
+struct sn2_override_fast_t final
+{
+	sn2_pwm_port_t pwm;
+
+	/* Handler side. */
+	std::atomic<std::uint32_t> posted; /* fast PWM writes made */
+	std::atomic<std::uint16_t> duty;   /* duty of the latest one */
+	sn2_override_latency_t latency;
+	sn2_seqlock_t<sn2_override_latency_t> latency_published;
+
+	/* loop() side. */
+	std::uint32_t synced; /* posted count the application has applied */
+	bool dropped;	      /* an application write was held off */
+};
+
+/**
+ * @brief Initialise before the write handler can run.
+ */
+static inline void sn2_override_fast_init(sn2_override_fast_t &fast, const sn2_pwm_port_t &pwm)
+{
+	fast.pwm = pwm;
+	fast.posted.store(0u, std::memory_order_relaxed);
+	fast.duty.store(0u, std::memory_order_relaxed);
+	fast.latency = sn2_override_latency_t{};
+	sn2_seqlock_init(fast.latency_published, fast.latency);
+	fast.synced = 0u;
+	fast.dropped = false;
+}
+
+/**
+ * @brief Write handler: drive the PWM now if the packet enables override.
+ * @param fast Fast path state.
+ * @param pkt Packet accepted by sn2_control_parse() and already posted
+ *	  to the control mailbox.
+ * @return true if the PWM was written.
+ */
+static inline bool sn2_override_fast_apply(sn2_override_fast_t &fast, const control_packet_t &pkt)
+{
+	const bool enable =
+	    ble_control_flag_is_set(pkt.command_flags, ble_control_flag_t::override_enable);
+
+	if (enable)
+	{
+		const std::uint16_t duty = ble_clamp_duty_per_mille(pkt.duty_override);
+
+		/* Count first, so an application write from here on yields. */
+		fast.duty.store(duty, std::memory_order_relaxed);
+		fast.posted.fetch_add(1u, std::memory_order_release);
+		fast.pwm.write(fast.pwm.context, duty);
+	}
+
+	return enable;
+}
+
+/**
+ * @brief Write handler: account one fast write's latency.
+ * @param fast Fast path state.
+ * @param latency_us Microseconds from handler entry to PWM update.
+ */
+static inline void sn2_override_fast_record(sn2_override_fast_t &fast, std::uint32_t latency_us)
+{
+	fast.latency.total_us += latency_us;
+	fast.latency.count += 1u;
+	fast.latency.last_us = latency_us;
+	fast.latency.max_us = (latency_us > fast.latency.max_us) ? latency_us : fast.latency.max_us;
+	sn2_seqlock_write(fast.latency_published, fast.latency);
+}
+
+/**
+ * @brief loop(): fast writes made so far, read before taking the mailbox.
+ */
+static inline std::uint32_t sn2_override_fast_mark(const sn2_override_fast_t &fast)
+{
+	return fast.posted.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief loop(): the mailbox taken after mark() has been applied.
+ * @return true if the PWM may no longer match the application's cached
+ *	   duty (a fast write or a held-off write since the last sync), so
+ *	   the application must write its duty again.
+ * @note Fast writes counted in mark were posted to the mailbox before
+ *	 they were counted, so the taken packet includes them.
+ */
+static inline bool sn2_override_fast_sync(sn2_override_fast_t &fast, std::uint32_t mark)
+{
+	const bool stale = (mark != fast.synced) || fast.dropped;
+
+	fast.synced = mark;
+	fast.dropped = false;
+
+	return stale;
+}
+
+/**
+ * @brief loop(): fan write decided by the application.
+ * @param fast Fast path state.
+ * @param duty Duty in per-mille.
+ */
+static inline void sn2_override_fast_app_write(sn2_override_fast_t &fast, std::uint16_t duty)
+{
+	const std::uint32_t before = fast.posted.load(std::memory_order_acquire);
+
+	if (before == fast.synced)
+	{
+		fast.pwm.write(fast.pwm.context, duty);
+		if (fast.posted.load(std::memory_order_acquire) != before)
+		{
+			/* A fast write may have landed first; it is newer. */
+			fast.pwm.write(fast.pwm.context, fast.duty.load(std::memory_order_relaxed));
+		}
+	}
+	else
+	{
+		fast.dropped = true;
+	}
+}
+
+/**
+ * @brief Any thread: consistent copy of the latency statistics.
+ */
+static inline void sn2_override_fast_latency(const sn2_override_fast_t &fast,
+					     sn2_override_latency_t &latency)
+{
+	(void)sn2_seqlock_read(fast.latency_published, latency);
+}
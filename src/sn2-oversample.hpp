@@ -0,0 +1,72 @@
+/**
+ * @file	sn2-oversample.hpp
+ * @brief	Oversample-and-decimate for slow ADC channels
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Summing 4^n conversions of a slowly varying signal and shifting the
+ * sum right by n (rounding to nearest) yields a code with n more bits
+ * than the ADC: 16x gives a 14-bit and 64x a 15-bit code from the 12-bit
+ * Photon 2 ADC. This only gains resolution when the input carries at
+ * least about one LSB of noise to dither the conversions, which the
+ * thermistor divider and ADC reference provide.
+ *
+ * The burst is taken back-to-back, once when the value is needed,
+ * rather than spread over loop() iterations.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Oversampling limits.
+ */
+struct sn2_oversample_constants_t final
+{
+	/* 256x of a 12-bit ADC still fits the decimated code in 16 bits. */
+	static constexpr std::uint8_t max_bits = 4u;
+};
+
+/**
+ * @brief Conversions in one burst for n extra bits (4^n).
+ */
+static inline constexpr std::uint32_t sn2_oversample_count(std::uint8_t bits)
+{
+	return static_cast<std::uint32_t>(1u) << (2u * bits);
+}
+
+/**
+ * @brief Decimate the sum of a burst, rounding to nearest.
+ * @param sum Sum of sn2_oversample_count(bits) conversions.
+ * @param bits Extra bits.
+ * @return Code with bits more resolution than one conversion.
+ */
+static inline constexpr std::uint16_t sn2_oversample_decimate(std::uint32_t sum,
+							      std::uint8_t bits)
+{
+	return static_cast<std::uint16_t>((sum + ((static_cast<std::uint32_t>(1u) << bits) >> 1)) >>
+					  bits);
+}
+
+/**
+ * @brief Take one burst and decimate it.
+ * @param read Callable returning one conversion.
+ * @param bits Extra bits (at most max_bits).
+ * @return Oversampled code.
+ */
+template <typename Read>
+static inline std::uint16_t sn2_oversample_burst(Read read, std::uint8_t bits)
+{
+	const std::uint32_t count = sn2_oversample_count(bits);
+	std::uint32_t sum = 0u;
+
+	for (std::uint32_t i = 0u; i < count; ++i)
+	{
+		sum += static_cast<std::uint32_t>(read());
+	}
+
+	return sn2_oversample_decimate(sum, bits);
+}
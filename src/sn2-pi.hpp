@@ -0,0 +1,143 @@
+/**
+ * @file	sn2-pi.hpp
+ * @brief	Fixed-point PI controller for the fan
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Drives the fan duty (per-mille) from the temperature (centi-degrees)
+ * once per control tick. The controller is direct-acting: a reading
+ * above the setpoint raises the duty. Gains are Q8 fixed point, and
+ * products are formed in 64 bits, so every tick is exact integer
+ * arithmetic and replays bit for bit.
+ *
+ * - Anti-windup: the integral is clamped to the output range, and it
+ *   does not integrate while the output is saturated in the direction
+ *   the error pushes (conditional integration).
+ * - Slew limit: the output moves at most slew_max per tick, so a step
+ *   in temperature or setpoint does not slam the fan.
+ * - Tracking: while something else commands the fan (the CN override),
+ *   sn2_pi_track() back-calculates the integral from that duty, so
+ *   control resumes from it without a bump.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Fixed-point format of the gains and the integral.
+ */
+struct sn2_pi_constants_t final
+{
+	static constexpr unsigned q = 8u;
+};
+
+/**
+ * @brief PI tuning.
+ */
+struct sn2_pi_config_t final
+{
+	std::int16_t setpoint_centi;
+	std::int32_t kp_q8;	  /* per-mille per centi-degree */
+	std::int32_t ki_q8;	  /* per-mille per centi-degree per tick */
+	std::uint16_t output_min; /* per-mille */
+	std::uint16_t output_max; /* per-mille */
+	std::uint16_t slew_max;	  /* per-mille per tick, 0 = unlimited */
+};
+
+/**
+ * @brief PI state.
+ */
+struct sn2_pi_t final
+{
+	std::int32_t integral_q8; /* integral term, per-mille in Q8 */
+	std::uint16_t output;	  /* per-mille */
+};
+
+/**
+ * @brief Reset to output_min with an empty integral.
+ */
+static inline void sn2_pi_init(sn2_pi_t &pi, const sn2_pi_config_t &cfg)
+{
+	pi.integral_q8 = static_cast<std::int32_t>(cfg.output_min) << sn2_pi_constants_t::q;
+	pi.output = cfg.output_min;
+}
+
+/**
+ * @brief Clamp a Q8 value to the output range.
+ */
+static inline std::int64_t sn2_pi_clamp_q8(const sn2_pi_config_t &cfg, std::int64_t value)
+{
+	const std::int64_t lo = static_cast<std::int64_t>(cfg.output_min) << sn2_pi_constants_t::q;
+	const std::int64_t hi = static_cast<std::int64_t>(cfg.output_max) << sn2_pi_constants_t::q;
+
+	return (value < lo) ? lo : ((value > hi) ? hi : value);
+}
+
+/**
+ * @brief Run one control tick.
+ * @param pi Controller state.
+ * @param cfg Tuning.
+ * @param measurement_centi Temperature in centi-degrees.
+ * @return New output in per-mille (also in pi.output).
+ */
+static inline std::uint16_t sn2_pi_update(sn2_pi_t &pi,
+					  const sn2_pi_config_t &cfg,
+					  std::int16_t measurement_centi)
+{
+	const std::int32_t error = static_cast<std::int32_t>(measurement_centi) - cfg.setpoint_centi;
+	const std::int64_t p = static_cast<std::int64_t>(cfg.kp_q8) * error;
+	std::int64_t integral = sn2_pi_clamp_q8(
+	    cfg, pi.integral_q8 + static_cast<std::int64_t>(cfg.ki_q8) * error);
+	std::int64_t u = p + integral;
+	const std::int64_t limited = sn2_pi_clamp_q8(cfg, u);
+
+	if (((u > limited) && (error > 0)) || ((u < limited) && (error < 0)))
+	{
+		/* Saturated and the error pushes further out: hold the integral. */
+		integral = pi.integral_q8;
+		u = p + integral;
+	}
+
+	/* Non-negative after clamping, so the shift rounds to nearest. */
+	const std::int32_t target = static_cast<std::int32_t>(
+	    (sn2_pi_clamp_q8(cfg, u) + ((static_cast<std::int64_t>(1) << sn2_pi_constants_t::q) >> 1)) >>
+	    sn2_pi_constants_t::q);
+	std::int32_t delta = target - pi.output;
+
+	if (cfg.slew_max != 0u)
+	{
+		delta = (delta > cfg.slew_max) ? cfg.slew_max
+					       : ((delta < -cfg.slew_max) ? -cfg.slew_max : delta);
+	}
+
+	pi.integral_q8 = static_cast<std::int32_t>(integral);
+	pi.output = static_cast<std::uint16_t>(pi.output + delta);
+
+	return pi.output;
+}
+
+/**
+ * @brief Follow an output commanded by something else.
+ * @param pi Controller state.
+ * @param cfg Tuning.
+ * @param measurement_centi Temperature in centi-degrees.
+ * @param output Duty actually commanded, in per-mille.
+ * @note Sets the integral so that a tick at the same temperature would
+ *	 reproduce output (within the output range).
+ */
+static inline void sn2_pi_track(sn2_pi_t &pi,
+				const sn2_pi_config_t &cfg,
+				std::int16_t measurement_centi,
+				std::uint16_t output)
+{
+	const std::int32_t error = static_cast<std::int32_t>(measurement_centi) - cfg.setpoint_centi;
+	const std::int64_t held = sn2_pi_clamp_q8(
+	    cfg, static_cast<std::int64_t>(output) << sn2_pi_constants_t::q);
+
+	pi.integral_q8 = static_cast<std::int32_t>(
+	    sn2_pi_clamp_q8(cfg, held - static_cast<std::int64_t>(cfg.kp_q8) * error));
+	pi.output = static_cast<std::uint16_t>(held >> sn2_pi_constants_t::q);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file	sn2-sampler.hpp
+ * @brief	Block ring between an ADC sampling producer and loop()
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * A fixed ring of Blocks sample blocks shared by one producer (a DMA
+ * completion interrupt, or a sampling thread where the platform has no
+ * ADC DMA) and one consumer (loop()). The producer fills the block
+ * returned by sn2_sampler_fill() and publishes it with
+ * sn2_sampler_commit() together with a Tag (at least a timestamp; the
+ * acquisition layer uses the slow-channel scan taken at the end of the
+ * block); the consumer processes whole blocks with
+ * sn2_sampler_peek()/sn2_sampler_release(). With Blocks = 2 this is the
+ * classic ping-pong double buffer.
+ *
+ * Both sides are wait-free. If the consumer falls behind and every
+ * other block is still unread, the newest block is discarded (its
+ * buffer is refilled) and counted in overruns, so a block the consumer
+ * is reading is never overwritten.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief SPSC ring of fixed-size ADC sample blocks.
+ * @tparam BlockSamples Samples per block.
+ * @tparam Blocks Number of blocks (power of two, >= 2).
+ * @tparam Tag Trivially copyable value published with each block.
+ */
+template <std::size_t BlockSamples, std::size_t Blocks, typename Tag>
+struct sn2_sampler_t final
+{
+	static_assert(Blocks >= 2u, "sampler needs at least two blocks");
+	static_assert((Blocks & (Blocks - 1u)) == 0u,
+		      "sampler block count must be a power of two");
+
+	static constexpr std::size_t block_samples = BlockSamples;
+	static constexpr std::size_t blocks = Blocks;
+
+	std::uint16_t samples[Blocks][BlockSamples];
+	Tag tags[Blocks];
+
+	/* Blocks committed by the producer / released by the consumer. */
+	std::atomic<std::uint32_t> head;
+	std::atomic<std::uint32_t> tail;
+	std::atomic<std::uint32_t> overruns;
+};
+
+/**
+ * @brief Reset a sampler to empty.
+ */
+template <std::size_t BlockSamples, std::size_t Blocks, typename Tag>
+static inline void sn2_sampler_init(sn2_sampler_t<BlockSamples, Blocks, Tag> &sampler)
+{
+	sampler.head.store(0u, std::memory_order_relaxed);
+	sampler.tail.store(0u, std::memory_order_relaxed);
+	sampler.overruns.store(0u, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Producer: block to fill next (the DMA destination).
+ */
+template <std::size_t BlockSamples, std::size_t Blocks, typename Tag>
+static inline std::uint16_t *sn2_sampler_fill(sn2_sampler_t<BlockSamples, Blocks, Tag> &sampler)
+{
+	const std::uint32_t head = sampler.head.load(std::memory_order_relaxed);
+
+	return sampler.samples[head & (Blocks - 1u)];
+}
+
+/**
+ * @brief Producer: publish the block returned by sn2_sampler_fill().
+ * @param sampler Sampler.
+ * @param tag Value describing the block (e.g. millis() of its last
+ *	  sample).
+ * @return true if published, false if the ring was full and the block
+ *	   was dropped (overruns is incremented).
+ */
+template <std::size_t BlockSamples, std::size_t Blocks, typename Tag>
+static inline bool sn2_sampler_commit(sn2_sampler_t<BlockSamples, Blocks, Tag> &sampler,
+				      const Tag &tag)
+{
+	const std::uint32_t head = sampler.head.load(std::memory_order_relaxed);
+	const std::uint32_t tail = sampler.tail.load(std::memory_order_acquire);
+	bool ok = (head - tail) < (Blocks - 1u);
+
+	if (ok)
+	{
+		sampler.tags[head & (Blocks - 1u)] = tag;
+		sampler.head.store(head + 1u, std::memory_order_release);
+	}
+	else
+	{
+		sampler.overruns.fetch_add(1u, std::memory_order_relaxed);
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Consumer: oldest unread block, if any.
+ * @param sampler Sampler.
+ * @param samples Set to the block's BlockSamples samples.
+ * @param tag Set to the block's tag.
+ * @return true if a block is available, otherwise false.
+ */
+template <std::size_t BlockSamples, std::size_t Blocks, typename Tag>
+static inline bool sn2_sampler_peek(sn2_sampler_t<BlockSamples, Blocks, Tag> &sampler,
+				    const std::uint16_t *&samples,
+				    Tag &tag)
+{
+	const std::uint32_t tail = sampler.tail.load(std::memory_order_relaxed);
+	const bool ok = tail != sampler.head.load(std::memory_order_acquire);
+
+	if (ok)
+	{
+		samples = sampler.samples[tail & (Blocks - 1u)];
+		tag = sampler.tags[tail & (Blocks - 1u)];
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Consumer: return the block from sn2_sampler_peek() to the producer.
+ */
+template <std::size_t BlockSamples, std::size_t Blocks, typename Tag>
+static inline void sn2_sampler_release(sn2_sampler_t<BlockSamples, Blocks, Tag> &sampler)
+{
+	const std::uint32_t tail = sampler.tail.load(std::memory_order_relaxed);
+
+	sampler.tail.store(tail + 1u, std::memory_order_release);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file	sn2-seqlock.hpp
+ * @brief	Sequence-lock publication of a small value to many readers
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * One writer publishes a value of T that any number of readers on other
+ * threads copy out. The writer makes the sequence odd, stores the value
+ * and makes the sequence even again; it never waits. A reader copies
+ * the value between two loads of the sequence and retries if the
+ * sequence was odd or changed, so it never returns a torn value and
+ * never holds a lock the writer could wait on.
+ *
+ * The value is kept as atomic words, stored with release and loaded
+ * with acquire ordering, so the concurrent copy is not a data race: a
+ * reader that sees any word of a write also sees that write's odd
+ * sequence on its second load and discards the copy. This avoids
+ * standalone fences, which ThreadSanitizer does not model. T must be
+ * trivially copyable.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Seqlock-protected value.
+ * @tparam T Trivially copyable value type.
+ */
+template <typename T>
+struct sn2_seqlock_t final
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+		      "seqlock value must be trivially copyable");
+
+	static constexpr std::size_t words = (sizeof(T) + 3u) / 4u;
+
+	std::atomic<std::uint32_t> sequence; /* odd while a write is in progress */
+	std::atomic<std::uint32_t> data[words];
+};
+
+/**
+ * @brief Initialise with a first value.
+ */
+template <typename T>
+static inline void sn2_seqlock_init(sn2_seqlock_t<T> &lock, const T &value)
+{
+	std::uint32_t words[sn2_seqlock_t<T>::words] = {};
+
+	std::memcpy(words, &value, sizeof(T));
+	for (std::size_t i = 0u; i < sn2_seqlock_t<T>::words; ++i)
+	{
+		lock.data[i].store(words[i], std::memory_order_relaxed);
+	}
+	lock.sequence.store(0u, std::memory_order_release);
+}
+
+/**
+ * @brief Writer: publish a new value. Only one thread may write.
+ */
+template <typename T>
+static inline void sn2_seqlock_write(sn2_seqlock_t<T> &lock, const T &value)
+{
+	const std::uint32_t seq = lock.sequence.load(std::memory_order_relaxed);
+	std::uint32_t words[sn2_seqlock_t<T>::words] = {};
+
+	std::memcpy(words, &value, sizeof(T));
+	lock.sequence.store(seq + 1u, std::memory_order_relaxed);
+	for (std::size_t i = 0u; i < sn2_seqlock_t<T>::words; ++i)
+	{
+		lock.data[i].store(words[i], std::memory_order_release);
+	}
+	lock.sequence.store(seq + 2u, std::memory_order_release);
+}
+
+/**
+ * @brief Reader: one attempt at a consistent copy.
+ * @param lock Seqlock.
+ * @param value Set to the published value on success.
+ * @return false if a write overlapped the copy (value is unchanged).
+ */
+template <typename T>
+static inline bool sn2_seqlock_try_read(const sn2_seqlock_t<T> &lock, T &value)
+{
+	std::uint32_t words[sn2_seqlock_t<T>::words];
+	const std::uint32_t before = lock.sequence.load(std::memory_order_acquire);
+
+	for (std::size_t i = 0u; i < sn2_seqlock_t<T>::words; ++i)
+	{
+		words[i] = lock.data[i].load(std::memory_order_acquire);
+	}
+
+	const bool ok = ((before & 1u) == 0u) &&
+			(lock.sequence.load(std::memory_order_relaxed) == before);
+
+	if (ok)
+	{
+		std::memcpy(&value, words, sizeof(T));
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Reader: copy the published value, retrying over concurrent
+ *	  writes.
+ * @return Number of attempts that were discarded.
+ */
+template <typename T>
+static inline std::uint32_t sn2_seqlock_read(const sn2_seqlock_t<T> &lock, T &value)
+{
+	std::uint32_t retries = 0u;
+
+	while (!sn2_seqlock_try_read(lock, value))
+	{
+		++retries;
+	}
+
+	return retries;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file	sn2-sound.cpp
+ * @brief	Block-based sound detection
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ */
+
+#include "sn2-sound.hpp"
+
+namespace
+{
+
+typedef sn2_sound_constants_t sn2_sc;
+
+constexpr double sn2_sound_fs = static_cast<double>(sn2_sc::sample_rate_hz);
+
+constexpr sn2_biquad_q15_t sn2_sound_band[sn2_sc::sections] = {
+    sn2_biquad_design_q15(sn2_biquad_type_t::highpass, sn2_sc::highpass_hz,
+			  sn2_sc::butterworth_q, sn2_sound_fs),
+    sn2_biquad_design_q15(sn2_biquad_type_t::lowpass, sn2_sc::lowpass_hz,
+			  sn2_sc::butterworth_q, sn2_sound_fs),
+};
+
+constexpr std::int16_t sn2_sound_attack =
+    sn2_envelope_coeff_q15(sn2_sc::attack_ms, sn2_sound_fs);
+constexpr std::int16_t sn2_sound_release =
+    sn2_envelope_coeff_q15(sn2_sc::release_ms, sn2_sound_fs);
+
+static_assert(sn2_sound_release > 0, "release too slow for Q15");
+
+/* 12-bit ADC counts -> Q15 is a 4-bit shift; Q31 envelope -> Q15 is 16. */
+constexpr int sn2_sound_q15_shift = 4;
+
+} // namespace
+
+void sn2_sound_init(sn2_sound_detector_t &detector,
+		    std::uint16_t min_margin,
+		    std::uint8_t deviations,
+		    std::uint8_t floor_shift)
+{
+	sn2_biquad_cascade_init(detector.band, sn2_sound_band);
+	sn2_envelope_init(detector.envelope, sn2_sound_attack, sn2_sound_release);
+	sn2_noise_floor_init(detector.floor, floor_shift);
+	detector.min_margin = min_margin;
+	detector.deviations = deviations;
+	detector.level = 0u;
+	detector.state = false;
+}
+
+bool sn2_sound_process(sn2_sound_detector_t &detector,
+		       const std::uint16_t *samples,
+		       std::size_t count)
+{
+	std::int16_t block[sn2_sc::block_samples];
+	std::int32_t peak = 0;
+
+	if ((samples != nullptr) && (count != 0u))
+	{
+		for (std::size_t first = 0u; first < count; first += sn2_sc::block_samples)
+		{
+			const std::size_t n = ((count - first) < sn2_sc::block_samples)
+						  ? (count - first)
+						  : sn2_sc::block_samples;
+
+			for (std::size_t i = 0u; i < n; ++i)
+			{
+				const std::int32_t centred =
+				    static_cast<std::int32_t>(samples[first + i]) - sn2_sc::adc_mid;
+
+				block[i] = sn2_sat_q15(centred * (1 << sn2_sound_q15_shift));
+			}
+			sn2_biquad_cascade_process(detector.band, block, block, n);
+
+			const std::int32_t p = sn2_envelope_process(detector.envelope, block, n);
+
+			peak = (p > peak) ? p : peak;
+		}
+
+		const std::int32_t level = peak >> sn2_filter_constants_t::envelope_shift;
+		const std::int32_t margin =
+		    static_cast<std::int32_t>(detector.min_margin) << sn2_sound_q15_shift;
+
+		detector.level = static_cast<std::uint16_t>(level >> sn2_sound_q15_shift);
+		if (!detector.state)
+		{
+			detector.state = detector.floor.primed &&
+					 sn2_noise_floor_exceeds(detector.floor, level,
+								 detector.deviations, margin);
+		}
+		else
+		{
+			detector.state = sn2_noise_floor_exceeds(
+			    detector.floor, level,
+			    static_cast<std::uint8_t>(detector.deviations / 2u), margin / 2);
+		}
+		if (!detector.state)
+		{
+			sn2_noise_floor_update(detector.floor, level);
+		}
+		else
+		{
+			sn2_noise_floor_drift(detector.floor, level, sn2_sc::present_floor_shift);
+		}
+	}
+
+	return detector.state;
+}
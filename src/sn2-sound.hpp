@@ -0,0 +1,97 @@
+/**
+ * @file	sn2-sound.hpp
+ * @brief	Block-based sound sampling and detection
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * The microphone channel is sampled at sample_rate_hz into blocks of
+ * block_samples by the acquisition layer (sn2-acquire.hpp), and loop()
+ * hands each complete block to the detector. Detection therefore runs once
+ * per block on contiguous samples instead of once per analogRead().
+ *
+ * The detector centres each block to Q15, band-limits it with a
+ * high-pass/low-pass biquad cascade (sn2-filter.hpp) and follows its
+ * envelope; the block level is the envelope peak in ADC counts.
+ *
+ * Sound is present when the level stands out from an adaptive noise
+ * floor (sn2-noise-floor.hpp) of past quiet blocks by more than a
+ * configured number of standard deviations and a minimum margin. Once
+ * present it clears at half of both, so a level hovering at the
+ * boundary does not chatter. While sound is present the floor mean
+ * keeps drifting towards the level with a 2^present_floor_shift times
+ * longer time constant (about 30 s instead of 2 s at the default
+ * shift), so a lasting rise in ambient noise ends a detection within a
+ * minute or two instead of latching it on.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sn2-filter.hpp"
+#include "sn2-noise-floor.hpp"
+
+/**
+ * @brief Sound sampling constants.
+ */
+struct sn2_sound_constants_t final
+{
+	static constexpr std::uint32_t sample_rate_hz = 8000u;
+	static constexpr std::size_t block_samples = 64u;
+	static constexpr std::int32_t adc_mid = 2048;
+
+	/* Pass band and envelope time constants. */
+	static constexpr double highpass_hz = 150.0;
+	static constexpr double lowpass_hz = 2500.0;
+	static constexpr double butterworth_q = 0.7071;
+	static constexpr double attack_ms = 1.0;
+	static constexpr double release_ms = 40.0;
+	static constexpr std::size_t sections = 2u;
+
+	/* Extra noise-floor weight exponent for blocks with sound present. */
+	static constexpr std::uint8_t present_floor_shift = 4u;
+};
+
+/**
+ * @brief Per-block sound detector state.
+ */
+struct sn2_sound_detector_t final
+{
+	sn2_biquad_cascade_q15_t<sn2_sound_constants_t::sections> band;
+	sn2_envelope_q31_t envelope;
+	sn2_noise_floor_t floor; /* of block levels in 1/16 ADC counts */
+	std::uint16_t min_margin;
+	std::uint8_t deviations;
+	std::uint16_t level;
+	bool state;
+};
+
+/**
+ * @brief Initialise a detector.
+ * @param detector Detector to initialise.
+ * @param min_margin Minimum level above the noise floor (ADC counts).
+ * @param deviations Noise-floor standard deviations a level must exceed.
+ * @param floor_shift Noise-floor weight exponent; the floor follows
+ *	  roughly the last 2^floor_shift quiet blocks.
+ */
+void sn2_sound_init(sn2_sound_detector_t &detector,
+		    std::uint16_t min_margin,
+		    std::uint8_t deviations,
+		    std::uint8_t floor_shift);
+
+/**
+ * @brief Process one block.
+ * @param detector Detector state.
+ * @param samples Raw ADC samples.
+ * @param count Number of samples.
+ * @return Sound state after the block.
+ * @note The block level is the peak envelope of the filtered block in
+ *	 ADC counts. The noise floor learns from blocks without sound and
+ *	 drifts slowly towards blocks with it.
+ */
+bool sn2_sound_process(sn2_sound_detector_t &detector,
+		       const std::uint16_t *samples,
+		       std::size_t count);
@@ -0,0 +1,153 @@
+/**
+ * @file	sn2-thermistor.hpp
+ * @brief	Compile-time thermistor linearisation table
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * The NTC thermistor sits on the low side of a divider to 3V3, so the
+ * ADC code maps to temperature through the divider ratio and the Beta
+ * equation:
+ *
+ *   R = R_div code / (adc_max - code)
+ *   1/T = 1/T0 + ln(R / R0) / Beta
+ *
+ * sn2_thermistor_lut() evaluates that curve in a constant expression at
+ * segments + 1 evenly spaced codes and stores centi-degrees
+ * Celsius (ble_protocol_constants_t::temperature_centi_per_c).
+ * sn2_thermistor_centi() then converts a reading with one table lookup
+ * and one multiply (linear interpolation inside a segment), with no libm
+ * and a fixed cost per sample.
+ *
+ * Breakpoints whose temperature falls outside the int16 range (the open
+ * and shorted ends of the divider) are saturated; the application
+ * reports those codes as sensor faults anyway.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../protocol/ble-protocol.hpp"
+#include "sn2-cx-math.hpp"
+
+/**
+ * @brief Divider and thermistor parameters.
+ */
+struct sn2_thermistor_params_t final
+{
+	double r0_ohm;        /* resistance at t0_c */
+	double t0_c;
+	double beta;
+	double divider_r_ohm; /* fixed resistor to 3V3 */
+	std::uint16_t adc_max;
+};
+
+/**
+ * @brief Table geometry for a 12-bit ADC.
+ */
+struct sn2_thermistor_constants_t final
+{
+	static constexpr unsigned adc_bits = 12u;
+	static constexpr unsigned segment_bits = 5u; /* 32 codes per segment */
+	static constexpr std::size_t segments =
+	    static_cast<std::size_t>(1u) << (adc_bits - segment_bits);
+	static constexpr double kelvin_offset = 273.15;
+};
+
+/**
+ * @brief Centi-degree temperature at every segment boundary.
+ */
+struct sn2_thermistor_lut_t final
+{
+	std::int16_t centi[sn2_thermistor_constants_t::segments + 1u];
+};
+
+/**
+ * @brief Parameters of the SN2 board (10k NTC, Beta 3950, 10k divider).
+ */
+static inline constexpr sn2_thermistor_params_t sn2_thermistor_default_params()
+{
+	return sn2_thermistor_params_t{10000.0, 25.0, 3950.0, 10000.0, 4095u};
+}
+
+/**
+ * @brief Exact curve, for table generation and host-side checks.
+ * @return Temperature in degrees Celsius at an ADC code strictly
+ *	   between 0 and adc_max.
+ */
+static inline constexpr double sn2_thermistor_celsius(const sn2_thermistor_params_t &p,
+						      double code)
+{
+	const double r = (p.divider_r_ohm * code) / (static_cast<double>(p.adc_max) - code);
+	const double inv_t = (1.0 / (p.t0_c + sn2_thermistor_constants_t::kelvin_offset)) +
+			     (sn2_cx_log(r / p.r0_ohm) / p.beta);
+
+	return (1.0 / inv_t) - sn2_thermistor_constants_t::kelvin_offset;
+}
+
+/**
+ * @brief Build the table for a set of parameters.
+ */
+static inline constexpr sn2_thermistor_lut_t sn2_thermistor_lut(const sn2_thermistor_params_t &p)
+{
+	constexpr double centi_per_c =
+	    static_cast<double>(ble_protocol_constants_t::temperature_centi_per_c);
+	sn2_thermistor_lut_t lut{};
+
+	for (std::size_t i = 0u; i <= sn2_thermistor_constants_t::segments; ++i)
+	{
+		const double code =
+		    static_cast<double>(i << sn2_thermistor_constants_t::segment_bits);
+		/* Code 0 is a shorted thermistor (hottest), adc_max and above open. */
+		double centi = 32767.0;
+
+		if (code >= static_cast<double>(p.adc_max))
+		{
+			centi = -32767.0;
+		}
+		else if (code > 0.0)
+		{
+			centi = sn2_thermistor_celsius(p, code) * centi_per_c;
+		}
+
+		centi = (centi > 32767.0) ? 32767.0 : ((centi < -32767.0) ? -32767.0 : centi);
+		lut.centi[i] = static_cast<std::int16_t>((centi >= 0.0) ? (centi + 0.5)
+									: (centi - 0.5));
+	}
+
+	return lut;
+}
+
+/**
+ * @brief Table for sn2_thermistor_default_params(), built at compile time.
+ */
+inline constexpr sn2_thermistor_lut_t sn2_thermistor_default_lut =
+    sn2_thermistor_lut(sn2_thermistor_default_params());
+
+/**
+ * @brief Convert an ADC code to centi-degrees Celsius.
+ * @param lut Table.
+ * @param code ADC code with extra_bits more resolution than the ADC
+ *	  (sn2-oversample.hpp); codes above the range are clamped.
+ * @param extra_bits Oversampling bits carried by code.
+ * @return Interpolated temperature in centi-degrees Celsius.
+ */
+static inline std::int16_t sn2_thermistor_centi(const sn2_thermistor_lut_t &lut,
+						std::uint32_t code,
+						unsigned extra_bits = 0u)
+{
+	const unsigned shift = sn2_thermistor_constants_t::segment_bits + extra_bits;
+	const std::uint32_t code_max =
+	    (static_cast<std::uint32_t>(1u) << (sn2_thermistor_constants_t::adc_bits + extra_bits)) - 1u;
+	const std::uint32_t c = (code > code_max) ? code_max : code;
+	const std::size_t i = c >> shift;
+	const std::int32_t lo = lut.centi[i];
+	const std::int32_t hi = lut.centi[i + 1u];
+	const std::int32_t frac = static_cast<std::int32_t>(c & ((1u << shift) - 1u));
+	const std::int32_t round = 1 << (shift - 1u);
+
+	return static_cast<std::int16_t>(lo + ((((hi - lo) * frac) + round) >> shift));
+}
@@ -0,0 +1,420 @@
+/**
+ * @file	sn2-timer-wheel.hpp
+ * @brief	Hierarchical timer wheel driven from millis()
+ *
+ * @project	ELEC4740
+ * @date	2026-10-16
+ *
+ * @details
+ * Four levels of 64 slots at 1 ms resolution (level L slot = 64^L ms),
+ * covering 2^24 ms (about 4.6 hours) before a timer is parked in the top
+ * level and re-cascaded. Timers are intrusive, doubly-linked nodes owned
+ * by the caller, so there is no allocation and capacity is the number of
+ * sn2_timer_t objects the application declares.
+ *
+ * - Start and stop are O(1).
+ * - sn2_timer_wheel_run() dispatches every timer due at or before now_ms,
+ *   in expiry order. A bitmap per level lets it skip empty slots, so the
+ *   cost depends on the number of occupied slots crossed, not the number
+ *   of milliseconds elapsed or timers armed.
+ * - Timers due in the same millisecond run in the order they were started.
+ * - Due timers are dispatched from a due list the wheel owns: run()
+ *   moves a reached slot onto it and pops one timer per callback, so a
+ *   callback may stop or restart any timer, including one due in the
+ *   same millisecond that has not fired yet.
+ * - A timer armed for a tick the wheel has already processed (e.g.
+ *   expires_ms = now_ms after run(now_ms), or from a callback) goes
+ *   straight onto the due list, so it still fires on the next call.
+ *
+ * Times follow millis() and wrap at 2^32 ms; deadlines are compared
+ * with wrap-safe signed differences.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct sn2_timer_t;
+
+/**
+ * @brief Timer expiry callback.
+ * @param context Context given to sn2_timer_init().
+ * @param timer Expired timer (may be restarted from the callback).
+ * @param now_ms Time passed to sn2_timer_wheel_run().
+ */
+typedef void (*sn2_timer_fn)(void *context, sn2_timer_t &timer, std::uint32_t now_ms);
+
+/**
+ * @brief Intrusive timer node.
+ * @note Initialise with sn2_timer_init(); do not copy while armed.
+ */
+struct sn2_timer_t final
+{
+	sn2_timer_t *next;
+	sn2_timer_t *prev;
+	sn2_timer_fn callback;
+	void *context;
+	std::uint32_t expires_ms;
+	std::uint32_t period_ms;
+	std::uint8_t level;
+	std::uint8_t slot;
+	bool armed;
+};
+
+/**
+ * @brief Timer wheel.
+ * @note Initialise with sn2_timer_wheel_init() before use.
+ */
+struct sn2_timer_wheel_t final
+{
+	static constexpr std::uint32_t slot_bits = 6u;
+	static constexpr std::uint32_t slots = 1u << slot_bits;
+	static constexpr std::uint32_t slot_mask = slots - 1u;
+	static constexpr std::uint32_t levels = 4u;
+	static constexpr std::uint32_t span_ms = 1u << (slot_bits * levels);
+
+	/* Slot list heads and tails (tails keep same-tick start order). */
+	sn2_timer_t *head[levels][slots];
+	sn2_timer_t *tail[levels][slots];
+	std::uint64_t occupied[levels];
+
+	/* Timers awaiting dispatch (level == levels), in start order. */
+	sn2_timer_t *due_head;
+	sn2_timer_t *due_tail;
+
+	/* Next tick to process. */
+	std::uint32_t current_ms;
+};
+
+namespace sn2_timer_detail
+{
+
+inline bool reached(std::uint32_t now_ms, std::uint32_t deadline_ms)
+{
+	return static_cast<std::int32_t>(now_ms - deadline_ms) >= 0;
+}
+
+inline std::uint32_t ctz64(std::uint64_t bits)
+{
+	return static_cast<std::uint32_t>(__builtin_ctzll(bits));
+}
+
+inline sn2_timer_t *&head(sn2_timer_wheel_t &wheel, std::uint32_t level, std::uint32_t slot)
+{
+	return (level == sn2_timer_wheel_t::levels) ? wheel.due_head : wheel.head[level][slot];
+}
+
+inline sn2_timer_t *&tail(sn2_timer_wheel_t &wheel, std::uint32_t level, std::uint32_t slot)
+{
+	return (level == sn2_timer_wheel_t::levels) ? wheel.due_tail : wheel.tail[level][slot];
+}
+
+inline void link(sn2_timer_wheel_t &wheel, sn2_timer_t &timer)
+{
+	std::uint32_t delta = timer.expires_ms - wheel.current_ms;
+	std::uint32_t level = 0u;
+	std::uint32_t slot = 0u;
+
+	/* Far timers park at the top level. */
+	if (delta >= sn2_timer_wheel_t::span_ms)
+	{
+		delta = sn2_timer_wheel_t::span_ms - 1u;
+	}
+	while ((delta >> (sn2_timer_wheel_t::slot_bits * (level + 1u))) != 0u)
+	{
+		++level;
+	}
+
+	if (static_cast<std::int32_t>(timer.expires_ms - wheel.current_ms) < 0)
+	{
+		/* Due at a tick already processed: dispatch with the due list. */
+		level = sn2_timer_wheel_t::levels;
+	}
+	else
+	{
+		slot = ((wheel.current_ms + delta) >> (sn2_timer_wheel_t::slot_bits * level)) &
+		       sn2_timer_wheel_t::slot_mask;
+		wheel.occupied[level] |= (std::uint64_t{1u} << slot);
+	}
+
+	timer.level = static_cast<std::uint8_t>(level);
+	timer.slot = static_cast<std::uint8_t>(slot);
+	timer.next = nullptr;
+	timer.prev = tail(wheel, level, slot);
+	if (timer.prev != nullptr)
+	{
+		timer.prev->next = &timer;
+	}
+	else
+	{
+		head(wheel, level, slot) = &timer;
+	}
+	tail(wheel, level, slot) = &timer;
+	timer.armed = true;
+}
+
+inline void unlink(sn2_timer_wheel_t &wheel, sn2_timer_t &timer)
+{
+	const std::uint32_t level = timer.level;
+	const std::uint32_t slot = timer.slot;
+
+	if (timer.prev != nullptr)
+	{
+		timer.prev->next = timer.next;
+	}
+	else
+	{
+		head(wheel, level, slot) = timer.next;
+	}
+	if (timer.next != nullptr)
+	{
+		timer.next->prev = timer.prev;
+	}
+	else
+	{
+		tail(wheel, level, slot) = timer.prev;
+	}
+	if ((level < sn2_timer_wheel_t::levels) && (head(wheel, level, slot) == nullptr))
+	{
+		wheel.occupied[level] &= ~(std::uint64_t{1u} << slot);
+	}
+	timer.next = nullptr;
+	timer.prev = nullptr;
+	timer.armed = false;
+}
+
+/* Detach a whole slot and return its list in start order. */
+inline sn2_timer_t *take(sn2_timer_wheel_t &wheel, std::uint32_t level,
+			 std::uint32_t slot)
+{
+	sn2_timer_t *list = wheel.head[level][slot];
+
+	wheel.head[level][slot] = nullptr;
+	wheel.tail[level][slot] = nullptr;
+	wheel.occupied[level] &= ~(std::uint64_t{1u} << slot);
+
+	return list;
+}
+
+/* Append a reached level-0 slot to the due list. */
+inline void make_due(sn2_timer_wheel_t &wheel, std::uint32_t slot)
+{
+	sn2_timer_t *const list = take(wheel, 0u, slot);
+	sn2_timer_t *last = nullptr;
+
+	for (sn2_timer_t *timer = list; timer != nullptr; timer = timer->next)
+	{
+		timer->level = static_cast<std::uint8_t>(sn2_timer_wheel_t::levels);
+		timer->slot = 0u;
+		last = timer;
+	}
+	if (list == nullptr)
+	{
+		return;
+	}
+
+	list->prev = wheel.due_tail;
+	if (wheel.due_tail != nullptr)
+	{
+		wheel.due_tail->next = list;
+	}
+	else
+	{
+		wheel.due_head = list;
+	}
+	wheel.due_tail = last;
+}
+
+/* Dispatch the due list one timer at a time, re-arming periodic ones.
+ * The head is re-read after every callback, so timers the callback
+ * stopped are never run and timers it made due are run in turn. */
+inline std::size_t fire(sn2_timer_wheel_t &wheel, std::uint32_t now_ms)
+{
+	std::size_t fired = 0u;
+
+	while (wheel.due_head != nullptr)
+	{
+		sn2_timer_t &timer = *wheel.due_head;
+
+		unlink(wheel, timer);
+		if (timer.period_ms != 0u)
+		{
+			std::uint32_t again = timer.expires_ms + timer.period_ms;
+
+			if (reached(now_ms, again))
+			{
+				again = now_ms + timer.period_ms;
+			}
+			timer.expires_ms = again;
+			link(wheel, timer);
+		}
+		timer.callback(timer.context, timer, now_ms);
+		++fired;
+	}
+
+	return fired;
+}
+
+/* Move timers from the upper levels down as current_ms enters their slot. */
+inline void cascade(sn2_timer_wheel_t &wheel)
+{
+	std::uint32_t top = 0u;
+
+	while (((top + 1u) < sn2_timer_wheel_t::levels) &&
+	       ((wheel.current_ms &
+		 ((1u << (sn2_timer_wheel_t::slot_bits * (top + 1u))) - 1u)) == 0u))
+	{
+		++top;
+	}
+
+	for (std::uint32_t level = top; level > 0u; --level)
+	{
+		const std::uint32_t slot =
+		    (wheel.current_ms >> (sn2_timer_wheel_t::slot_bits * level)) &
+		    sn2_timer_wheel_t::slot_mask;
+		sn2_timer_t *timer = take(wheel, level, slot);
+
+		while (timer != nullptr)
+		{
+			sn2_timer_t *const next = timer->next;
+
+			link(wheel, *timer);
+			timer = next;
+		}
+	}
+}
+
+} // namespace sn2_timer_detail
+
+/**
+ * @brief Initialise a timer wheel.
+ * @param wheel Wheel to initialise.
+ * @param now_ms Current millis().
+ */
+static inline void sn2_timer_wheel_init(sn2_timer_wheel_t &wheel, std::uint32_t now_ms)
+{
+	wheel = sn2_timer_wheel_t{};
+	wheel.current_ms = now_ms;
+}
+
+/**
+ * @brief Initialise a timer.
+ * @param timer Timer to initialise.
+ * @param callback Expiry callback.
+ * @param context Context passed to the callback.
+ */
+static inline void sn2_timer_init(sn2_timer_t &timer, sn2_timer_fn callback,
+				  void *context)
+{
+	timer = sn2_timer_t{};
+	timer.callback = callback;
+	timer.context = context;
+}
+
+/**
+ * @brief Arm (or re-arm) a timer.
+ * @param wheel Timer wheel.
+ * @param timer Timer to arm.
+ * @param expires_ms Absolute millis() deadline.
+ * @param period_ms Repeat period, or 0 for one-shot.
+ * @note A periodic timer is re-armed at expires_ms + period_ms; if that
+ *	 is already in the past (e.g. after a stall) it resynchronises to
+ *	 now_ms + period_ms instead of firing a burst of catch-up calls.
+ */
+static inline void sn2_timer_start(sn2_timer_wheel_t &wheel,
+				   sn2_timer_t &timer,
+				   std::uint32_t expires_ms,
+				   std::uint32_t period_ms)
+{
+	if (timer.armed)
+	{
+		sn2_timer_detail::unlink(wheel, timer);
+	}
+	timer.expires_ms = expires_ms;
+	timer.period_ms = period_ms;
+	sn2_timer_detail::link(wheel, timer);
+}
+
+/**
+ * @brief Disarm a timer; no effect if it is not armed.
+ */
+static inline void sn2_timer_stop(sn2_timer_wheel_t &wheel, sn2_timer_t &timer)
+{
+	if (timer.armed)
+	{
+		sn2_timer_detail::unlink(wheel, timer);
+	}
+}
+
+/**
+ * @brief Dispatch every timer due at or before now_ms.
+ * @param wheel Timer wheel.
+ * @param now_ms Current millis().
+ * @return Number of callbacks run.
+ */
+static inline std::size_t sn2_timer_wheel_run(sn2_timer_wheel_t &wheel,
+					      std::uint32_t now_ms)
+{
+	const std::uint32_t end = now_ms + 1u;
+	std::size_t fired = sn2_timer_detail::fire(wheel, now_ms);
+
+	while (static_cast<std::int32_t>(end - wheel.current_ms) > 0)
+	{
+		const std::uint32_t index = wheel.current_ms & sn2_timer_wheel_t::slot_mask;
+
+		if (index == 0u)
+		{
+			sn2_timer_detail::cascade(wheel);
+		}
+
+		const std::uint64_t pending = wheel.occupied[0] >> index;
+
+		if (pending == 0u)
+		{
+			/* Nothing left in this block: jump to the next block, or at
+			 * a block start to the next occupied level-1 slot, stopping
+			 * at the level-1 rotation where level 2 cascades. */
+			std::uint32_t skip = sn2_timer_wheel_t::slots - index;
+
+			if (index == 0u)
+			{
+				const std::uint32_t index1 =
+				    (wheel.current_ms >> sn2_timer_wheel_t::slot_bits) &
+				    sn2_timer_wheel_t::slot_mask;
+				const std::uint64_t pending1 = wheel.occupied[1] >> index1;
+				const std::uint32_t blocks =
+				    (pending1 != 0u) ? sn2_timer_detail::ctz64(pending1)
+						     : (sn2_timer_wheel_t::slots - index1);
+
+				skip = ((blocks != 0u) ? blocks : 1u)
+				       << sn2_timer_wheel_t::slot_bits;
+			}
+
+			if (static_cast<std::int32_t>(end - wheel.current_ms) <=
+			    static_cast<std::int32_t>(skip))
+			{
+				wheel.current_ms = end;
+			}
+			else
+			{
+				wheel.current_ms += skip;
+			}
+			continue;
+		}
+
+		const std::uint32_t tick = wheel.current_ms + sn2_timer_detail::ctz64(pending);
+
+		if (!sn2_timer_detail::reached(now_ms, tick))
+		{
+			wheel.current_ms = end;
+			break;
+		}
+
+		sn2_timer_detail::make_due(wheel, tick & sn2_timer_wheel_t::slot_mask);
+		wheel.current_ms = tick + 1u;
+		fired += sn2_timer_detail::fire(wheel, now_ms);
+	}
+
+	return fired;
+}